@@ -6,17 +6,33 @@
 #define DESIGN_PATTERNS_CHAIN_OF_RESPONSIBILITY_H
 
 #include "../concepts.h"
+#include <algorithm>
 #include <functional>
+#include <latch>
+#include <numeric>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 namespace pf {
+/**
+ * Independent handlers may be reordered among their independent neighbours in adaptive mode,
+ * dependent handlers keep their position relative to all other handlers.
+ */
+enum class handler_order {
+  dependent,
+  independent
+};
+
 template<typename T, typename... Args>
 class chain_of_responsibility {
  public:
-  template<typename F>
-  void add_handler(invocable_returning<F, std::optional<T>, Args...> auto &&h) {
-    handlers.emplace_back(std::forward<F>(h));
+  using input_type = std::conditional_t<sizeof...(Args) == 1, std::tuple_element_t<0, std::tuple<std::decay_t<Args>..., void>>, std::tuple<std::decay_t<Args>...>>;
+
+  void add_handler(invocable_returning<std::optional<T>, Args...> auto &&h, handler_order order = handler_order::dependent) {
+    handlers.emplace_back(std::forward<decltype(h)>(h), order, handlers.size());
   }
 
   std::optional<T> operator()(Args &&... args) {
@@ -24,16 +40,213 @@ class chain_of_responsibility {
   }
 
   std::optional<T> notify(Args &&... args) {
-    for (const auto &h : handlers) {
-      if (auto res = h(args...); res.has_value()) {
+    if (reorder_period != 0 && ++notifications_since_reorder >= reorder_period) {
+      reorder();
+    }
+    for (auto &h : handlers) {
+      if (auto res = h.fnc(args...); res.has_value()) {
+        ++h.hits;
+        ++h.recent_hits;
         return res.value();
       }
     }
     return std::nullopt;
   }
 
+  /**
+   * Evaluates each handler over all still unhandled inputs before moving to the next one.
+   * outputs[i] receives the result for inputs[i].
+   */
+  void notify_batch(std::span<const input_type> inputs, std::span<std::optional<T>> outputs) {
+    check_batch_size(inputs, outputs);
+    auto hits = std::vector<std::size_t>(handlers.size());
+    evaluate_batch(inputs, outputs, hits);
+    commit_batch(hits, inputs.size());
+  }
+
+  /**
+   * Splits the batch into chunks of chunk_size evaluated on executor, blocks until all chunks are done.
+   * Handlers have to be safe to call concurrently.
+   */
+  void notify_batch(std::span<const input_type> inputs, std::span<std::optional<T>> outputs, executor auto &executor, std::size_t chunk_size) {
+    check_batch_size(inputs, outputs);
+    if (chunk_size == 0 || inputs.size() <= chunk_size) {
+      notify_batch(inputs, outputs);
+      return;
+    }
+    const auto chunk_count = (inputs.size() + chunk_size - 1) / chunk_size;
+    auto chunk_hits = std::vector<std::vector<std::size_t>>(chunk_count, std::vector<std::size_t>(handlers.size()));
+    auto done = std::latch{static_cast<std::ptrdiff_t>(chunk_count)};
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+      const auto offset = i * chunk_size;
+      const auto count = std::min(chunk_size, inputs.size() - offset);
+      executor.enqueue([this, &done, &hits = chunk_hits[i], chunk_inputs = inputs.subspan(offset, count), chunk_outputs = outputs.subspan(offset, count)] {
+        evaluate_batch(chunk_inputs, chunk_outputs, hits);
+        done.count_down();
+      });
+    }
+    done.wait();
+    auto hits = std::vector<std::size_t>(handlers.size());
+    for (const auto &chunk : chunk_hits) {
+      std::transform(hits.begin(), hits.end(), chunk.begin(), hits.begin(), std::plus<>{});
+    }
+    commit_batch(hits, inputs.size());
+  }
+
+  /**
+   * Every reorder_period notifications independent handlers are sorted by their recent hit count.
+   */
+  void enable_adaptive_order(std::size_t reorder_period) {
+    this->reorder_period = reorder_period;
+    notifications_since_reorder = 0;
+  }
+
+  void disable_adaptive_order() {
+    reorder_period = 0;
+  }
+
+  /**
+   * @return hit counts of handlers in the order they were added
+   */
+  [[nodiscard]] std::vector<std::size_t> hit_counts() const {
+    auto result = std::vector<std::size_t>(handlers.size());
+    for (const auto &h : handlers) {
+      result[h.id] = h.hits;
+    }
+    return result;
+  }
+
+ private:
+  struct handler {
+    handler(std::function<std::optional<T>(Args...)> fnc, handler_order order, std::size_t id)
+        : fnc(std::move(fnc)), order(order), id(id) {}
+    std::function<std::optional<T>(Args...)> fnc;
+    handler_order order;
+    std::size_t id;
+    std::size_t hits = 0;
+    std::size_t recent_hits = 0;
+  };
+
+  static void check_batch_size(std::span<const input_type> inputs, std::span<std::optional<T>> outputs) {
+    if (outputs.size() < inputs.size()) {
+      throw std::invalid_argument("Output span is smaller than input span in chain_of_responsibility.");
+    }
+  }
+
+  void evaluate_batch(std::span<const input_type> inputs, std::span<std::optional<T>> outputs, std::vector<std::size_t> &hits) const {
+    std::fill_n(outputs.begin(), inputs.size(), std::nullopt);
+    auto pending = std::vector<std::size_t>(inputs.size());
+    std::iota(pending.begin(), pending.end(), 0);
+    for (std::size_t h = 0; h < handlers.size() && !pending.empty(); ++h) {
+      const auto &fnc = handlers[h].fnc;
+      auto remaining = pending.begin();
+      for (const auto idx : pending) {
+        auto res = std::optional<T>{};
+        if constexpr (sizeof...(Args) == 1) {
+          res = fnc(inputs[idx]);
+        } else {
+          res = std::apply(fnc, inputs[idx]);
+        }
+        if (res.has_value()) {
+          outputs[idx] = std::move(res);
+          ++hits[h];
+        } else {
+          *remaining++ = idx;
+        }
+      }
+      pending.erase(remaining, pending.end());
+    }
+  }
+
+  void commit_batch(const std::vector<std::size_t> &hits, std::size_t batch_size) {
+    for (std::size_t h = 0; h < handlers.size(); ++h) {
+      handlers[h].hits += hits[h];
+      handlers[h].recent_hits += hits[h];
+    }
+    if (reorder_period != 0) {
+      notifications_since_reorder += batch_size;
+      if (notifications_since_reorder >= reorder_period) {
+        reorder();
+      }
+    }
+  }
+
+  void reorder() {
+    notifications_since_reorder = 0;
+    auto run_begin = handlers.begin();
+    while (run_begin != handlers.end()) {
+      run_begin = std::find_if(run_begin, handlers.end(), [](const auto &h) { return h.order == handler_order::independent; });
+      const auto run_end = std::find_if(run_begin, handlers.end(), [](const auto &h) { return h.order == handler_order::dependent; });
+      std::stable_sort(run_begin, run_end, [](const auto &lhs, const auto &rhs) { return lhs.recent_hits > rhs.recent_hits; });
+      run_begin = run_end;
+    }
+    for (auto &h : handlers) {
+      h.recent_hits /= 2;
+    }
+  }
+
+  std::vector<handler> handlers;
+  std::size_t reorder_period = 0;
+  std::size_t notifications_since_reorder = 0;
+};
+
+namespace details {
+template<typename HandlerTuple, typename... Args>
+struct static_chain_result {};
+template<typename H, typename... Hs, typename... Args>
+struct static_chain_result<std::tuple<H, Hs...>, Args...> {
+  using type = std::invoke_result_t<H &, Args &...>;
+};
+}// namespace details
+
+/**
+ * Chain with handlers fixed at compile time, notify is a fold over the handlers so calls can be inlined.
+ * add_handler returns a new chain type.
+ */
+template<typename... Handlers>
+class static_chain {
+  template<typename... Args>
+  using result_type = typename details::static_chain_result<std::tuple<Handlers...>, Args...>::type;
+
+ public:
+  constexpr static_chain() requires(std::default_initializable<Handlers> &&...) = default;
+  constexpr explicit static_chain(Handlers... handlers) : handlers(std::move(handlers)...) {}
+
+  template<typename F>
+  [[nodiscard]] constexpr static_chain<Handlers..., std::decay_t<F>> add_handler(F &&h) const & {
+    return std::apply([&h](const auto &... hs) {
+      return static_chain<Handlers..., std::decay_t<F>>{hs..., std::forward<F>(h)};
+    }, handlers);
+  }
+
+  template<typename F>
+  [[nodiscard]] constexpr static_chain<Handlers..., std::decay_t<F>> add_handler(F &&h) && {
+    return std::apply([&h](auto &... hs) {
+      return static_chain<Handlers..., std::decay_t<F>>{std::move(hs)..., std::forward<F>(h)};
+    }, handlers);
+  }
+
+  template<typename... Args>
+  requires(sizeof...(Handlers) > 0 && (invocable_returning<Handlers &, result_type<Args...>, Args &...> && ...))
+  constexpr result_type<Args...> operator()(Args &&... args) {
+    return notify(std::forward<Args>(args)...);
+  }
+
+  template<typename... Args>
+  requires(sizeof...(Handlers) > 0 && (invocable_returning<Handlers &, result_type<Args...>, Args &...> && ...))
+  constexpr result_type<Args...> notify(Args &&... args) {
+    auto result = result_type<Args...>{std::nullopt};
+    std::apply([&](auto &... hs) {
+      ((result = std::invoke(hs, args...)).has_value() || ...);
+    }, handlers);
+    return result;
+  }
+
  private:
-  std::vector<std::function<std::optional<T>(Args...)>> handlers;
+  std::tuple<Handlers...> handlers;
 };
+
+template<typename... Handlers>
+static_chain(Handlers...) -> static_chain<Handlers...>;
 }// namespace pf
 #endif//DESIGN_PATTERNS_CHAIN_OF_RESPONSIBILITY_H
@@ -4,10 +4,288 @@
 
 #ifndef DESIGN_PATTERNS_VISITOR_H
 #define DESIGN_PATTERNS_VISITOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+
 namespace pf {
 template<typename... Ts>
 struct visitor : Ts... { using Ts::operator()...; };
 template<class... Ts>
 visitor(Ts...) -> visitor<Ts...>;
+
+namespace details {
+template<typename R>
+using range_variant_t = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+template<typename R>
+inline constexpr std::size_t range_variant_size_v = std::variant_size_v<range_variant_t<R>>;
+
+/**
+ * Counting sort of element indices by variant::index().
+ * Indices of alternative I are order[offsets[I]] to order[offsets[I + 1]].
+ */
+template<std::ranges::random_access_range R>
+struct alternative_groups {
+  explicit alternative_groups(R &range) : order(std::ranges::size(range)) {
+    for (const auto &element : range) {
+      if (element.valueless_by_exception()) {
+        throw std::bad_variant_access{};
+      }
+      ++offsets[element.index() + 1];
+    }
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+    auto positions = offsets;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      order[positions[range[i].index()]++] = i;
+    }
+  }
+
+  std::array<std::size_t, range_variant_size_v<R> + 1> offsets{};
+  std::vector<std::size_t> order;
+};
+
+/**
+ * Calls f(index, alternative) for every element of range, one alternative type after another.
+ */
+template<std::ranges::random_access_range R>
+void for_each_by_alternative(R &range, auto &&f) {
+  const auto groups = alternative_groups<R>{range};
+  const auto visit_group = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+    for (auto i = groups.offsets[I]; i < groups.offsets[I + 1]; ++i) {
+      const auto index = groups.order[i];
+      f(index, *std::get_if<I>(&range[index]));
+    }
+  };
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    (visit_group(std::integral_constant<std::size_t, Is>{}), ...);
+  }(std::make_index_sequence<range_variant_size_v<R>>{});
+}
+}// namespace details
+
+/**
+ * Visits all variants in range grouped by their active alternative, so each overload runs over a homogeneous run.
+ * Elements are visited out of their original order.
+ */
+template<std::ranges::random_access_range R, typename Visitor>
+requires std::ranges::sized_range<R>
+void visit_batch(R &&range, Visitor &&visitor) {
+  details::for_each_by_alternative(range, [&visitor](std::size_t, auto &&alternative) {
+    std::invoke(visitor, std::forward<decltype(alternative)>(alternative));
+  });
+}
+
+/**
+ * Same as visit_batch, the result of visiting range[i] is written to out[i] which keeps the original order in the output.
+ */
+template<std::ranges::random_access_range R, typename Visitor, std::random_access_iterator Out>
+requires std::ranges::sized_range<R>
+void visit_batch(R &&range, Visitor &&visitor, Out out) {
+  details::for_each_by_alternative(range, [&visitor, &out](std::size_t index, auto &&alternative) {
+    out[index] = std::invoke(visitor, std::forward<decltype(alternative)>(alternative));
+  });
+}
+
+namespace details {
+/**
+ * Folds std::common_type pairwise through an operator, a single std::common_type over the results of large
+ * dispatch tables exceeds the template instantiation depth.
+ */
+template<typename T>
+struct common_type_fold {
+  using type = T;
+  template<typename U>
+  common_type_fold<std::common_type_t<T, U>> operator|(common_type_fold<U>) const;
+};
+
+/**
+ * Alternative I of variant with the variant's value category, the active index has to be I.
+ */
+template<std::size_t I, typename Variant>
+constexpr decltype(auto) get_unchecked(Variant &&variant) {
+  auto alternative = std::get_if<I>(&variant);
+  if constexpr (std::is_lvalue_reference_v<Variant>) {
+    return *alternative;
+  } else {
+    return std::move(*alternative);
+  }
+}
+
+template<typename Visitor, typename... Variants>
+struct multi_visit_table {
+  static constexpr std::size_t arity = sizeof...(Variants);
+  static constexpr std::array<std::size_t, arity> sizes{std::variant_size_v<std::remove_cvref_t<Variants>>...};
+  static constexpr std::size_t size = (std::variant_size_v<std::remove_cvref_t<Variants>> * ... * 1);
+
+  static constexpr std::array<std::size_t, arity> unflatten(std::size_t flat) {
+    auto result = std::array<std::size_t, arity>{};
+    for (auto k = arity; k-- > 0;) {
+      result[k] = flat % sizes[k];
+      flat /= sizes[k];
+    }
+    return result;
+  }
+
+  static constexpr std::size_t flatten(const std::remove_cvref_t<Variants> &... variants) {
+    std::size_t result = 0;
+    ((result = result * std::variant_size_v<std::remove_cvref_t<Variants>> + variants.index()), ...);
+    return result;
+  }
+
+  template<std::size_t Flat, std::size_t... Ks>
+  static auto result_at(std::index_sequence<Ks...>) -> std::invoke_result_t<Visitor &, decltype(std::get<unflatten(Flat)[Ks]>(std::declval<Variants>()))...>;
+
+  template<std::size_t... Flats>
+  static auto common_result(std::index_sequence<Flats...>)
+      -> std::common_type_t<typename decltype((... | common_type_fold<decltype(result_at<Flats>(std::make_index_sequence<arity>{}))>{}))::type>;
+
+  using result_type = decltype(common_result(std::make_index_sequence<size>{}));
+
+  template<std::size_t Flat, std::size_t... Ks>
+  static result_type dispatch_impl(std::index_sequence<Ks...>, Visitor &visitor, Variants &&... variants) {
+    constexpr auto indices = unflatten(Flat);
+    return std::invoke(visitor, get_unchecked<indices[Ks]>(std::forward<Variants>(variants))...);
+  }
+
+  template<std::size_t Flat>
+  static result_type dispatch(Visitor &visitor, Variants &&... variants) {
+    return dispatch_impl<Flat>(std::make_index_sequence<arity>{}, visitor, std::forward<Variants>(variants)...);
+  }
+
+  template<std::size_t... Flats>
+  static constexpr auto make_table(std::index_sequence<Flats...>) {
+    return std::array<result_type (*)(Visitor &, Variants &&...), size>{&dispatch<Flats>...};
+  }
+
+  static constexpr auto table = make_table(std::make_index_sequence<size>{});
+};
+}// namespace details
+
+/**
+ * Multiple dispatch over any number of variants through a single flattened table of function pointers,
+ * instead of nesting std::visit calls.
+ */
+template<typename Visitor, typename... Variants>
+requires(sizeof...(Variants) > 0)
+decltype(auto) multi_visit(Visitor &&visitor, Variants &&... variants) {
+  if ((variants.valueless_by_exception() || ...)) {
+    throw std::bad_variant_access{};
+  }
+  using table = details::multi_visit_table<std::remove_reference_t<Visitor>, Variants...>;
+  return table::table[table::flatten(variants...)](visitor, std::forward<Variants>(variants)...);
+}
+
+/**
+ * Binary visitor for which (A, B) and (B, A) share one overload, arguments are swapped when only the other order exists.
+ */
+template<typename Visitor>
+struct symmetric {
+  Visitor visitor;
+
+  template<typename A, typename B>
+  requires std::invocable<Visitor &, A, B> || std::invocable<Visitor &, B, A>
+  constexpr decltype(auto) operator()(A &&a, B &&b) {
+    if constexpr (std::invocable<Visitor &, A, B>) {
+      return std::invoke(visitor, std::forward<A>(a), std::forward<B>(b));
+    } else {
+      return std::invoke(visitor, std::forward<B>(b), std::forward<A>(a));
+    }
+  }
+
+  template<typename A, typename B>
+  requires std::invocable<const Visitor &, A, B> || std::invocable<const Visitor &, B, A>
+  constexpr decltype(auto) operator()(A &&a, B &&b) const {
+    if constexpr (std::invocable<const Visitor &, A, B>) {
+      return std::invoke(visitor, std::forward<A>(a), std::forward<B>(b));
+    } else {
+      return std::invoke(visitor, std::forward<B>(b), std::forward<A>(a));
+    }
+  }
+};
+template<typename Visitor>
+symmetric(Visitor) -> symmetric<Visitor>;
+
+/**
+ * Base of a closed_hierarchy root, holds the type tag of the most derived object.
+ */
+struct type_tagged {
+  std::uint8_t type_tag = 0;
+};
+
+/**
+ * Sets the type tag of Self on construction, used as the direct parent of each derived type:
+ * struct Derived : pf::tag_as<Hierarchy, Derived, Parent> {...};
+ */
+template<typename Hierarchy, typename Self, typename Parent>
+struct tag_as : Parent {
+  tag_as() : Parent() {
+    Parent::type_tag = Hierarchy::template tag_of<Self>();
+  }
+
+  template<typename... Args>
+  requires(sizeof...(Args) > 0 && !(sizeof...(Args) == 1 && (std::derived_from<std::remove_cvref_t<Args>, tag_as> && ...)))
+  explicit tag_as(Args &&... args) : Parent(std::forward<Args>(args)...) {
+    Parent::type_tag = Hierarchy::template tag_of<Self>();
+  }
+};
+
+/**
+ * Closed set of types derived from Base, dispatches visitors over Base & through a table indexed by the type tag
+ * instead of virtual calls. Base is tag 0, Derived types follow in the listed order.
+ */
+template<typename Base, typename... Derived>
+class closed_hierarchy {
+  static_assert(sizeof...(Derived) < 255, "Too many types for closed_hierarchy type tag.");
+
+  template<typename Object, typename T>
+  using like_t = std::conditional_t<std::is_const_v<Object>, const T, T>;
+
+ public:
+  template<typename T>
+  static constexpr std::uint8_t tag_of() {
+    constexpr std::array matches{std::is_same_v<T, Base>, std::is_same_v<T, Derived>...};
+    constexpr auto index = std::find(matches.begin(), matches.end(), true) - matches.begin();
+    static_assert(index < matches.size(), "Type is not a member of closed_hierarchy.");
+    return static_cast<std::uint8_t>(index);
+  }
+
+  template<typename T, typename Object>
+  requires std::same_as<std::remove_const_t<Object>, Base>
+  static bool holds(Object &object) {
+    return object.type_tag == tag_of<T>();
+  }
+
+  template<typename Visitor, typename Object>
+  requires std::same_as<std::remove_const_t<Object>, Base>
+  static decltype(auto) visit(Visitor &&visitor, Object &object) {
+    static_assert(std::derived_from<Base, type_tagged> && (std::derived_from<Derived, Base> && ...));
+    using visited_base = std::conditional_t<std::is_abstract_v<Base>, like_t<Object, std::tuple_element_t<0, std::tuple<Derived...>>>, Object>;
+    using result_type = std::common_type_t<std::invoke_result_t<Visitor, visited_base &>, std::invoke_result_t<Visitor, like_t<Object, Derived> &>...>;
+    using dispatch_fnc = result_type (*)(Visitor &, Object &);
+    static constexpr std::array<dispatch_fnc, sizeof...(Derived) + 1> table{&dispatch<Base, result_type, Visitor, Object>, &dispatch<Derived, result_type, Visitor, Object>...};
+    return table[object.type_tag](visitor, object);
+  }
+
+ private:
+  template<typename T, typename Result, typename Visitor, typename Object>
+  static Result dispatch(Visitor &visitor, Object &object) {
+    if constexpr (std::is_abstract_v<T>) {
+      throw std::bad_cast{};
+    } else {
+      return std::invoke(visitor, static_cast<like_t<Object, T> &>(object));
+    }
+  }
+};
 }// namespace pf
 #endif//DESIGN_PATTERNS_VISITOR_H
@@ -0,0 +1,37 @@
+#ifndef DESIGN_PATTERNS_BENCHMARK_H
+#define DESIGN_PATTERNS_BENCHMARK_H
+
+#include <chrono>
+#include <concepts>
+#include <cstdio>
+#include <string_view>
+
+namespace pf::bench {
+/**
+ * Keeps the compiler from optimizing away the computation of value.
+ */
+template<typename T>
+void do_not_optimize(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * Runs f iterations times after a short warm up and prints the mean time of one iteration.
+ * @return mean time of one iteration in nanoseconds
+ */
+template<std::invocable F>
+double run(std::string_view name, std::size_t iterations, F &&f) {
+  for (std::size_t i = 0; i < iterations / 10; ++i) {
+    f();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    f();
+  }
+  const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+  const auto result = elapsed.count() / static_cast<double>(iterations);
+  std::printf("%-48.*s %12.2f ns\n", static_cast<int>(name.size()), name.data(), result);
+  return result;
+}
+}// namespace pf::bench
+#endif//DESIGN_PATTERNS_BENCHMARK_H
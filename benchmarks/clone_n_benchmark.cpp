@@ -0,0 +1,50 @@
+#include "../creational/prototype.h"
+#include "benchmark.h"
+#include <string>
+#include <vector>
+
+namespace {
+struct Particle {
+  float position[3];
+  float velocity[3];
+  int type;
+};
+
+struct Entity {
+  std::string name = "entity";
+  std::vector<int> components = std::vector<int>(4, 1);
+};
+
+constexpr std::size_t entity_count = 10'000;
+
+template<typename T>
+void compare(const char *type_name, const T &instance, std::size_t iterations) {
+  const auto prototype = pf::prototype<T>{instance};
+  const auto name = [type_name](const char *method) {
+    return std::string{type_name} + ", " + method + " x10k";
+  };
+  pf::bench::run(name("cloneUnique"), iterations, [&] {
+    auto clones = std::vector<std::unique_ptr<T>>{};
+    clones.reserve(entity_count);
+    for (std::size_t i = 0; i < entity_count; ++i) {
+      clones.emplace_back(prototype.cloneUnique());
+    }
+    pf::bench::do_not_optimize(clones.back());
+  });
+  pf::bench::run(name("clone_n(n)"), iterations, [&] {
+    const auto clones = prototype.clone_n(entity_count);
+    pf::bench::do_not_optimize(clones.back());
+  });
+  auto buffer = std::vector<T>(entity_count, instance);
+  pf::bench::run(name("clone_n(n, out)"), iterations, [&] {
+    prototype.clone_n(entity_count, buffer.begin());
+    pf::bench::do_not_optimize(buffer.back());
+  });
+}
+}// namespace
+
+int main() {
+  compare("trivially copyable", Particle{{1, 2, 3}, {0, 1, 0}, 4}, 2000);
+  compare("non-trivial", Entity{}, 200);
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include "../creational/lazy_init.h"
+#include "benchmark.h"
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr std::size_t chain_count = 100;
+constexpr std::size_t chain_length = 100;
+
+/**
+ * chain_count independent chains of chain_length computed nodes, each chain fed by its own input.
+ */
+struct graph {
+  graph() {
+    for (std::size_t c = 0; c < chain_count; ++c) {
+      auto &input = inputs.emplace_back(std::make_unique<pf::input_node<int>>(static_cast<int>(c)));
+      pf::computed<int> *previous = nullptr;
+      for (std::size_t i = 0; i < chain_length; ++i) {
+        const auto increment = [](int value) { return value + 1; };
+        auto node = previous == nullptr ? std::make_unique<pf::computed<int>>(increment, *input)
+                                        : std::make_unique<pf::computed<int>>(increment, *previous);
+        previous = nodes.emplace_back(std::move(node)).get();
+      }
+      outputs.emplace_back(previous);
+    }
+  }
+
+  int read_outputs() {
+    auto sum = 0;
+    for (auto output : outputs) {
+      sum += **output;
+    }
+    return sum;
+  }
+
+  [[nodiscard]] std::size_t evaluations() const {
+    auto result = std::size_t{};
+    for (const auto &node : nodes) {
+      result += node->evaluations();
+    }
+    return result;
+  }
+
+  std::vector<std::unique_ptr<pf::input_node<int>>> inputs;
+  std::vector<std::unique_ptr<pf::computed<int>>> nodes;
+  std::vector<pf::computed<int> *> outputs;
+};
+}// namespace
+
+int main() {
+  constexpr std::size_t iterations = 1000;
+  auto g = graph{};
+  pf::bench::do_not_optimize(g.read_outputs());
+  std::printf("%zu computed nodes\n", g.nodes.size());
+
+  auto value = 0;
+  auto evaluations_before = g.evaluations();
+  pf::bench::run("set all inputs, read outputs", iterations, [&] {
+    ++value;
+    for (auto &input : g.inputs) {
+      input->set(value);
+    }
+    pf::bench::do_not_optimize(g.read_outputs());
+  });
+  std::printf("  evaluations per iteration %zu\n", (g.evaluations() - evaluations_before) / (iterations + iterations / 10));
+
+  evaluations_before = g.evaluations();
+  pf::bench::run("set one input, read outputs", iterations, [&] {
+    ++value;
+    g.inputs[static_cast<std::size_t>(value) % chain_count]->set(value);
+    pf::bench::do_not_optimize(g.read_outputs());
+  });
+  std::printf("  evaluations per iteration %zu\n", (g.evaluations() - evaluations_before) / (iterations + iterations / 10));
+
+  pf::bench::run("read outputs without changes", iterations, [&] {
+    pf::bench::do_not_optimize(g.read_outputs());
+  });
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include "../creational/lazy_init.h"
+#include "benchmark.h"
+#include <latch>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+int calculate_value() {
+  auto result = 0;
+  for (int i = 0; i < 1000; ++i) {
+    pf::bench::do_not_optimize(result += i);
+  }
+  return result;
+}
+
+/**
+ * Lazily initialized value built on std::call_once, the baseline.
+ */
+class call_once_lazy {
+ public:
+  const int &operator*() {
+    std::call_once(flag, [this] { value = calculate_value(); });
+    return *value;
+  }
+
+ private:
+  std::once_flag flag;
+  std::optional<int> value;
+};
+
+constexpr unsigned thread_count = 8;
+
+/**
+ * Creates a fresh Lazy, releases thread_count threads at once and lets each access it accesses times.
+ */
+template<typename Lazy>
+void run_contended(const std::string &name, std::size_t accesses, std::size_t rounds) {
+  pf::bench::run(name + ", " + std::to_string(accesses) + " accesses per thread", rounds, [accesses] {
+    auto lazy = Lazy{};
+    auto start = std::latch{thread_count};
+    auto threads = std::vector<std::thread>{};
+    for (unsigned t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&] {
+        start.arrive_and_wait();
+        auto sum = 0;
+        for (std::size_t i = 0; i < accesses; ++i) {
+          sum += *lazy;
+        }
+        pf::bench::do_not_optimize(sum);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  });
+}
+
+struct blocking_lazy : pf::concurrent_lazy_init<int, int (*)(), pf::lazy_wait::block> {
+  blocking_lazy() : concurrent_lazy_init(calculate_value) {}
+};
+struct spinning_lazy : pf::concurrent_lazy_init<int, int (*)(), pf::lazy_wait::spin> {
+  spinning_lazy() : concurrent_lazy_init(calculate_value) {}
+};
+}// namespace
+
+int main() {
+  std::printf("%u threads racing on a fresh instance, time per round\n", thread_count);
+  for (std::size_t accesses : {1, 1'000'000}) {
+    const auto rounds = accesses == 1 ? 2000 : 20;
+    run_contended<call_once_lazy>("std::call_once", accesses, rounds);
+    run_contended<blocking_lazy>("concurrent_lazy_init block", accesses, rounds);
+    run_contended<spinning_lazy>("concurrent_lazy_init spin", accesses, rounds);
+  }
+  return 0;
+}
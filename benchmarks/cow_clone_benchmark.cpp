@@ -0,0 +1,42 @@
+#include "../creational/prototype.h"
+#include "benchmark.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+struct Config {
+  std::string name = "default";
+  std::vector<int> thresholds = std::vector<int>(1024, 7);
+  std::map<std::string, std::string> options{{"mode", "fast"}, {"level", "3"}, {"region", "eu"}};
+};
+
+int read(const Config &config) {
+  return config.thresholds[10] + static_cast<int>(config.name.size());
+}
+}// namespace
+
+int main() {
+  constexpr std::size_t iterations = 1'000'000;
+  const auto prototype = pf::prototype<Config>{Config{}};
+
+  pf::bench::run("clone, read", iterations, [&] {
+    const auto clone = prototype.clone();
+    pf::bench::do_not_optimize(read(clone));
+  });
+  pf::bench::run("cloneCow, read", iterations, [&] {
+    const auto clone = prototype.cloneCow();
+    pf::bench::do_not_optimize(read(*clone));
+  });
+  pf::bench::run("clone, write", iterations, [&] {
+    auto clone = prototype.clone();
+    clone.thresholds[10] = 1;
+    pf::bench::do_not_optimize(read(clone));
+  });
+  pf::bench::run("cloneCow, write", iterations, [&] {
+    auto clone = prototype.cloneCow();
+    clone.mutate().thresholds[10] = 1;
+    pf::bench::do_not_optimize(read(*clone));
+  });
+  return 0;
+}
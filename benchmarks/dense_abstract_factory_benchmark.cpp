@@ -0,0 +1,49 @@
+#include "../creational/abstract_factory.h"
+#include "benchmark.h"
+
+namespace {
+enum class Shape { square, rectangle, triangle, circle, count };
+
+constexpr int square(int size) { return size * size; }
+constexpr int rectangle(int size) { return size * 2 * size; }
+constexpr int triangle(int size) { return size * size / 2; }
+constexpr int circle(int size) { return 3 * size * size; }
+}// namespace
+
+int main() {
+  constexpr std::size_t iterations = 20'000'000;
+  auto map_factory = pf::abstract_factory<Shape, int, int>{{
+      {Shape::square, square},
+      {Shape::rectangle, rectangle},
+      {Shape::triangle, triangle},
+      {Shape::circle, circle},
+  }};
+  auto dense_factory = pf::dense_abstract_factory<Shape, int, int>{
+      {Shape::square, square},
+      {Shape::rectangle, rectangle},
+      {Shape::triangle, triangle},
+      {Shape::circle, circle},
+  };
+  constexpr auto constexpr_factory = pf::constexpr_abstract_factory<Shape, int, int>{
+      {Shape::square, square},
+      {Shape::rectangle, rectangle},
+      {Shape::triangle, triangle},
+      {Shape::circle, circle},
+  };
+
+  int i = 0;
+  const auto next_shape = [&i] {
+    i = (i + 1) % static_cast<int>(Shape::count);
+    return static_cast<Shape>(i);
+  };
+  pf::bench::run("abstract_factory::create", iterations, [&] {
+    pf::bench::do_not_optimize(map_factory.create(next_shape(), int{i}));
+  });
+  pf::bench::run("dense_abstract_factory::create", iterations, [&] {
+    pf::bench::do_not_optimize(dense_factory.create(next_shape(), int{i}));
+  });
+  pf::bench::run("constexpr_abstract_factory::create", iterations, [&] {
+    pf::bench::do_not_optimize(constexpr_factory.create(next_shape(), int{i}));
+  });
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include "../creational/RAII.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+std::atomic<std::int64_t> latency_sum_ns = 0;
+std::atomic<std::int64_t> latency_max_ns = 0;
+std::atomic<std::size_t> freed = 0;
+
+struct Node {
+  explicit Node(int value) : value(value) {}
+  ~Node() {
+    if (retired_at != clock_type::time_point{}) {
+      const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - retired_at).count();
+      latency_sum_ns += latency;
+      auto max = latency_max_ns.load();
+      while (latency > max && !latency_max_ns.compare_exchange_weak(max, latency)) {}
+      ++freed;
+    }
+  }
+  int value;
+  clock_type::time_point retired_at{};
+};
+
+/**
+ * Readers pin and read the current node while one writer replaces and retires it writes times.
+ */
+void run_workload(unsigned reader_count, std::size_t writes, std::size_t batch_size) {
+  latency_sum_ns = 0;
+  latency_max_ns = 0;
+  freed = 0;
+  auto domain = pf::epoch_domain{128, batch_size};
+  auto current = std::atomic<Node *>{new Node{0}};
+  auto stop = std::atomic<bool>{false};
+  auto reads = std::atomic<std::size_t>{0};
+  auto readers = std::vector<std::thread>{};
+  for (unsigned r = 0; r < reader_count; ++r) {
+    readers.emplace_back([&] {
+      auto local_reads = std::size_t{};
+      auto sum = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto guard = domain.pin();
+        sum += current.load(std::memory_order_acquire)->value;
+        ++local_reads;
+      }
+      pf::bench::do_not_optimize(sum);
+      reads += local_reads;
+    });
+  }
+  const auto start = clock_type::now();
+  for (std::size_t i = 1; i <= writes; ++i) {
+    auto old = current.exchange(new Node{static_cast<int>(i)}, std::memory_order_acq_rel);
+    old->retired_at = clock_type::now();
+    domain.retire(old);
+  }
+  const auto elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+  stop = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  const auto freed_while_running = freed.load();
+  const auto mean_latency_us = freed_while_running == 0 ? 0.0 : static_cast<double>(latency_sum_ns) / static_cast<double>(freed_while_running) / 1000.0;
+  std::printf("%u readers, batch %4zu: %8.2f M retires/s, %8.2f M reads/s, freed %zu of %zu while running, latency mean %.1f us max %.1f us\n",
+              reader_count, batch_size, static_cast<double>(writes) / elapsed / 1e6, static_cast<double>(reads) / elapsed / 1e6,
+              freed_while_running, writes, mean_latency_us, static_cast<double>(latency_max_ns) / 1000.0);
+  delete current.load();
+}
+}// namespace
+
+int main() {
+  auto domain = pf::epoch_domain{};
+  pf::bench::run("pin and unpin, uncontended", 10'000'000, [&] {
+    const auto guard = domain.pin();
+  });
+  for (auto readers : {1u, 4u}) {
+    for (std::size_t batch_size : {16, 64, 1024}) {
+      run_workload(readers, 1'000'000, batch_size);
+    }
+  }
+  return 0;
+}
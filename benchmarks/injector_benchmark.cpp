@@ -0,0 +1,70 @@
+#include "../creational/dependency_injection.h"
+#include "benchmark.h"
+#include <any>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace {
+struct Config {
+  int level = 3;
+};
+struct Logger {
+  explicit Logger(Config &config) : config(config) {}
+  Config &config;
+  int messages = 0;
+};
+struct Repository {
+  Repository(Config &config, Logger &logger) : config(config), logger(logger) {}
+  Config &config;
+  Logger &logger;
+  int queries = 0;
+};
+struct Service {
+  Service(Repository &repository, Logger &logger) : repository(repository), logger(logger) {}
+  Repository &repository;
+  Logger &logger;
+};
+
+/**
+ * Service locator keyed by type, the runtime alternative to pf::injector.
+ */
+class type_map_locator {
+ public:
+  template<typename T>
+  void add(T &instance) {
+    instances.insert_or_assign(std::type_index{typeid(T)}, std::any{&instance});
+  }
+
+  template<typename T>
+  T &get() {
+    return *std::any_cast<T *>(instances.at(std::type_index{typeid(T)}));
+  }
+
+ private:
+  std::unordered_map<std::type_index, std::any> instances;
+};
+}// namespace
+
+int main() {
+  constexpr std::size_t iterations = 50'000'000;
+  auto injector = pf::injector<pf::bind<Config>, pf::bind<Logger, Config>, pf::bind<Repository, Config, Logger>,
+                               pf::bind<Service, Repository, Logger>>{};
+  auto locator = type_map_locator{};
+  locator.add(injector.get<Config>());
+  locator.add(injector.get<Logger>());
+  locator.add(injector.get<Repository>());
+  locator.add(injector.get<Service>());
+
+  pf::bench::run("injector::get", iterations, [&] {
+    ++injector.get<Service>().repository.queries;
+    ++injector.get<Logger>().messages;
+    pf::bench::do_not_optimize(injector.get<Config>().level);
+  });
+  pf::bench::run("type_index map lookup", iterations, [&] {
+    ++locator.get<Service>().repository.queries;
+    ++locator.get<Logger>().messages;
+    pf::bench::do_not_optimize(locator.get<Config>().level);
+  });
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include "../behavioral/visitor.h"
+#include "benchmark.h"
+#include <random>
+
+namespace {
+template<int I>
+struct Body {
+  int mass = I;
+};
+using Object = std::variant<Body<0>, Body<1>, Body<2>, Body<3>, Body<4>, Body<5>, Body<6>, Body<7>>;
+
+// handles each unordered pair once, symmetric provides the swapped order
+struct Interaction {
+  template<int I, int J>
+  requires(I <= J)
+  int operator()(const Body<I> &a, const Body<J> &b) const {
+    return a.mass * 8 + b.mass;
+  }
+};
+constexpr auto interact = pf::symmetric{Interaction{}};
+constexpr auto interact3 = [](const auto &a, const auto &b, const auto &c) {
+  return a.mass * 64 + b.mass * 8 + c.mass;
+};
+}// namespace
+
+int main() {
+  constexpr std::size_t count = 1'000'000;
+  constexpr std::size_t iterations = 50;
+  auto random = std::mt19937{7};
+  auto kind = std::uniform_int_distribution<std::size_t>{0, std::variant_size_v<Object> - 1};
+  auto objects = std::vector<Object>{};
+  objects.reserve(count + 2);
+  const auto objects_by_index = []<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::array<Object, sizeof...(Is)>{Object{std::in_place_index<Is>}...};
+  }(std::make_index_sequence<std::variant_size_v<Object>>{});
+  for (std::size_t i = 0; i < count + 2; ++i) {
+    objects.emplace_back(objects_by_index[kind(random)]);
+  }
+
+  pf::bench::run("nested std::visit, 2 args, 1M pairs", iterations, [&] {
+    auto sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += std::visit([&](const auto &a) {
+        return std::visit([&](const auto &b) { return interact(a, b); }, objects[i + 1]);
+      }, objects[i]);
+    }
+    pf::bench::do_not_optimize(sum);
+  });
+  pf::bench::run("std::visit, 2 args, 1M pairs", iterations, [&] {
+    auto sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += std::visit(interact, objects[i], objects[i + 1]);
+    }
+    pf::bench::do_not_optimize(sum);
+  });
+  pf::bench::run("multi_visit, 2 args, 1M pairs", iterations, [&] {
+    auto sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += pf::multi_visit(interact, objects[i], objects[i + 1]);
+    }
+    pf::bench::do_not_optimize(sum);
+  });
+  pf::bench::run("std::visit, 3 args, 1M triples", iterations, [&] {
+    auto sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += std::visit(interact3, objects[i], objects[i + 1], objects[i + 2]);
+    }
+    pf::bench::do_not_optimize(sum);
+  });
+  pf::bench::run("multi_visit, 3 args, 1M triples", iterations, [&] {
+    auto sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += pf::multi_visit(interact3, objects[i], objects[i + 1], objects[i + 2]);
+    }
+    pf::bench::do_not_optimize(sum);
+  });
+  return 0;
+}
@@ -0,0 +1,48 @@
+// Compile time benchmark, built as multi_visit_compile_benchmark and, with MULTI_VISIT_USE_STD_VISIT defined,
+// as std_visit_compile_benchmark. Compare the build times of the two targets.
+#include "../behavioral/visitor.h"
+#include <cstdio>
+
+namespace {
+template<int I>
+struct Alternative {
+  int value = I;
+};
+template<int Offset>
+using Variant = std::variant<Alternative<Offset>, Alternative<Offset + 1>, Alternative<Offset + 2>, Alternative<Offset + 3>,
+                             Alternative<Offset + 4>, Alternative<Offset + 5>, Alternative<Offset + 6>, Alternative<Offset + 7>>;
+
+template<int Offset>
+int visit_triple(const Variant<Offset> &a, const Variant<Offset + 8> &b, const Variant<Offset + 16> &c) {
+  const auto visitor = [](const auto &x, const auto &y, const auto &z) { return x.value * y.value + z.value; };
+#ifdef MULTI_VISIT_USE_STD_VISIT
+  return std::visit([&](const auto &x) {
+    return std::visit([&](const auto &y) {
+      return std::visit([&](const auto &z) { return visitor(x, y, z); }, c);
+    }, b);
+  }, a);
+#else
+  return pf::multi_visit(visitor, a, b, c);
+#endif
+}
+
+template<typename V>
+V make_variant(std::size_t index) {
+  return [index]<std::size_t... Is>(std::index_sequence<Is...>) {
+    constexpr auto variants = std::array<V, sizeof...(Is)>{V{std::in_place_index<Is>}...};
+    return variants[index % variants.size()];
+  }(std::make_index_sequence<std::variant_size_v<V>>{});
+}
+
+template<int Offset>
+int run(std::size_t index) {
+  return visit_triple<Offset>(make_variant<Variant<Offset>>(index), make_variant<Variant<Offset + 8>>(index + 1),
+                              make_variant<Variant<Offset + 16>>(index + 2));
+}
+}// namespace
+
+int main(int argc, char **) {
+  const auto index = static_cast<std::size_t>(argc);
+  std::printf("%d\n", run<0>(index) + run<100>(index) + run<200>(index) + run<300>(index));
+  return 0;
+}
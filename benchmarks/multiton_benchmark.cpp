@@ -0,0 +1,71 @@
+#include "../creational/multiton.h"
+#include "benchmark.h"
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+struct SquareCreator {
+  int operator()(int key) {
+    return key * key;
+  }
+};
+using Squares = pf::multiton<int, int, SquareCreator>;
+
+/**
+ * Registry with a single map guarded by one mutex, the straightforward thread safe alternative.
+ */
+class locked_registry {
+ public:
+  static int &get_instance(int key) {
+    std::unique_lock lock{mutex};
+    auto iter = instances.find(key);
+    if (iter == instances.end()) {
+      iter = instances.emplace(key, std::make_unique<int>(SquareCreator{}(key))).first;
+    }
+    return *iter->second;
+  }
+
+ private:
+  static inline std::mutex mutex;
+  static inline std::unordered_map<int, std::unique_ptr<int>> instances;
+};
+
+constexpr int key_count = 1024;
+constexpr std::size_t lookups_per_thread = 2'000'000;
+
+/**
+ * Looks up existing keys from thread_count threads, the printed time is the wall time of the whole run.
+ */
+void run_threads(const std::string &name, unsigned thread_count, auto &&lookup) {
+  pf::bench::run(name + ", " + std::to_string(thread_count) + " threads", 1, [&] {
+    auto threads = std::vector<std::thread>{};
+    for (unsigned t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&lookup, t] {
+        auto sum = 0;
+        for (std::size_t i = 0; i < lookups_per_thread; ++i) {
+          sum += lookup(static_cast<int>((i * 7 + t) % key_count));
+        }
+        pf::bench::do_not_optimize(sum);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  });
+}
+}// namespace
+
+int main() {
+  for (int key = 0; key < key_count; ++key) {
+    Squares::get_instance(key);
+    locked_registry::get_instance(key);
+  }
+  std::printf("time for %zu lookups in each thread\n", lookups_per_thread);
+  for (auto thread_count : {1u, 2u, 4u, 8u}) {
+    run_threads("mutex guarded map", thread_count, [](int key) { return locked_registry::get_instance(key); });
+    run_threads("multiton", thread_count, [](int key) { return *Squares::get_instance(key); });
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include "../creational/abstract_factory.h"
+#include "benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+std::size_t heap_allocations = 0;
+
+enum class Kind { small, medium, large };
+
+struct Product {
+  int value = 0;
+  virtual ~Product() = default;
+  virtual int get() const { return value; }
+};
+struct MediumProduct : Product {
+  std::array<int, 8> data{};
+  int get() const override { return value + data[0]; }
+};
+struct LargeProduct : Product {
+  std::array<int, 32> data{};
+  int get() const override { return value + data[0]; }
+};
+
+constexpr std::size_t burst_size = 1000;
+constexpr std::size_t bursts = 2000;
+
+/**
+ * Creates bursts of products and prints the time of one burst and heap allocations per burst.
+ */
+void run_bursts(const char *name, auto &factory, auto &&after_burst) {
+  using value_type = typename std::remove_reference_t<decltype(factory)>::value_type;
+  auto products = std::vector<value_type>{};
+  products.reserve(burst_size);
+  const auto allocations_before = heap_allocations;
+  pf::bench::run(name, bursts, [&] {
+    for (std::size_t i = 0; i < burst_size; ++i) {
+      products.emplace_back(factory.create(static_cast<Kind>(i % 3), static_cast<int>(i)));
+    }
+    pf::bench::do_not_optimize(products.back()->get());
+    products.clear();
+    after_burst();
+  });
+  const auto runs = bursts + bursts / 10;
+  std::printf("%-48s %12.2f\n", "  heap allocations per burst", static_cast<double>(heap_allocations - allocations_before) / runs);
+}
+}// namespace
+
+void *operator new(std::size_t size) {
+  ++heap_allocations;
+  if (auto ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  ++heap_allocations;
+  const auto align = static_cast<std::size_t>(alignment);
+  if (auto ptr = std::aligned_alloc(align, (size + align - 1) / align * align); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+int main() {
+  auto heap_factory = pf::abstract_factory<Kind, std::unique_ptr<Product>, int>{{
+      {Kind::small, [](int value) -> std::unique_ptr<Product> { auto result = std::make_unique<Product>(); result->value = value; return result; }},
+      {Kind::medium, [](int value) -> std::unique_ptr<Product> { auto result = std::make_unique<MediumProduct>(); result->value = value; return result; }},
+      {Kind::large, [](int value) -> std::unique_ptr<Product> { auto result = std::make_unique<LargeProduct>(); result->value = value; return result; }},
+  }};
+  const auto pooled_constructors = [] {
+    return pf::pooled_abstract_factory<Kind, Product, int>::constructor_map{
+        {Kind::small, [](pf::product_allocator<Product> alloc, int value) { auto result = alloc.make<Product>(); result->value = value; return result; }},
+        {Kind::medium, [](pf::product_allocator<Product> alloc, int value) { auto result = alloc.make<MediumProduct>(); result->value = value; return result; }},
+        {Kind::large, [](pf::product_allocator<Product> alloc, int value) { auto result = alloc.make<LargeProduct>(); result->value = value; return result; }},
+    };
+  };
+  auto pooled_factory = pf::pooled_abstract_factory<Kind, Product, int>{pooled_constructors()};
+  auto arena = std::pmr::monotonic_buffer_resource{std::pmr::new_delete_resource()};
+  auto arena_factory = pf::pooled_abstract_factory<Kind, Product, int>{pooled_constructors(), arena};
+
+  run_bursts("abstract_factory make_unique burst", heap_factory, [] {});
+  run_bursts("pooled_abstract_factory pool burst", pooled_factory, [] {});
+  run_bursts("pooled_abstract_factory arena burst", arena_factory, [&arena] { arena.release(); });
+  return 0;
+}
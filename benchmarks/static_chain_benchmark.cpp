@@ -0,0 +1,45 @@
+#include "../behavioral/chain_of_responsibility.h"
+#include "benchmark.h"
+#include <string>
+#include <utility>
+
+namespace {
+template<int I>
+struct equals_handler {
+  std::optional<int> operator()(int value) const {
+    return value == I ? std::optional{I} : std::nullopt;
+  }
+};
+
+template<std::size_t HandlerCount>
+void compare(std::size_t iterations) {
+  auto runtime_chain = pf::chain_of_responsibility<int, int>{};
+  for (int i = 0; i < static_cast<int>(HandlerCount); ++i) {
+    runtime_chain.add_handler([i](int value) { return value == i ? std::optional{i} : std::nullopt; });
+  }
+  auto static_chain = []<std::size_t... Is>(std::index_sequence<Is...>) {
+    return pf::static_chain{equals_handler<Is>{}...};
+  }(std::make_index_sequence<HandlerCount>{});
+
+  // inputs cycle over all handlers and one value no handler accepts
+  int input = 0;
+  const auto next_input = [&input] {
+    input = input == static_cast<int>(HandlerCount) ? 0 : input + 1;
+    return input;
+  };
+  const auto count = std::to_string(HandlerCount);
+  pf::bench::run("chain_of_responsibility " + count + " handlers", iterations, [&] {
+    pf::bench::do_not_optimize(runtime_chain.notify(next_input()));
+  });
+  pf::bench::run("static_chain " + count + " handlers", iterations, [&] {
+    pf::bench::do_not_optimize(static_chain.notify(next_input()));
+  });
+}
+}// namespace
+
+int main() {
+  compare<4>(10'000'000);
+  compare<16>(10'000'000);
+  compare<64>(2'000'000);
+  return 0;
+}
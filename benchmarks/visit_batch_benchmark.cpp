@@ -0,0 +1,71 @@
+#include "../behavioral/visitor.h"
+#include "benchmark.h"
+#include <random>
+
+namespace {
+struct Circle {
+  float radius;
+};
+struct Square {
+  float side;
+};
+struct Rectangle {
+  float width;
+  float height;
+};
+struct Triangle {
+  float base;
+  float height;
+};
+using Shape = std::variant<Circle, Square, Rectangle, Triangle>;
+
+constexpr auto area = pf::visitor{
+    [](const Circle &c) { return 3.14159f * c.radius * c.radius; },
+    [](const Square &s) { return s.side * s.side; },
+    [](const Rectangle &r) { return r.width * r.height; },
+    [](const Triangle &t) { return 0.5f * t.base * t.height; },
+};
+}// namespace
+
+int main() {
+  constexpr std::size_t element_count = 1'000'000;
+  constexpr std::size_t iterations = 50;
+  auto random = std::mt19937{42};
+  auto kind = std::uniform_int_distribution<int>{0, 3};
+  auto shapes = std::vector<Shape>{};
+  shapes.reserve(element_count);
+  for (std::size_t i = 0; i < element_count; ++i) {
+    const auto size = static_cast<float>(i % 100);
+    switch (kind(random)) {
+      case 0: shapes.emplace_back(Circle{size}); break;
+      case 1: shapes.emplace_back(Square{size}); break;
+      case 2: shapes.emplace_back(Rectangle{size, 2}); break;
+      default: shapes.emplace_back(Triangle{size, 3}); break;
+    }
+  }
+  auto areas = std::vector<float>(element_count);
+
+  pf::bench::run("std::visit loop, 1M variants", iterations, [&] {
+    auto sum = 0.0f;
+    for (const auto &shape : shapes) {
+      sum += std::visit(area, shape);
+    }
+    pf::bench::do_not_optimize(sum);
+  });
+  pf::bench::run("visit_batch, 1M variants", iterations, [&] {
+    auto sum = 0.0f;
+    pf::visit_batch(shapes, [&sum](const auto &shape) { sum += area(shape); });
+    pf::bench::do_not_optimize(sum);
+  });
+  pf::bench::run("std::visit loop to output, 1M variants", iterations, [&] {
+    for (std::size_t i = 0; i < element_count; ++i) {
+      areas[i] = std::visit(area, shapes[i]);
+    }
+    pf::bench::do_not_optimize(areas.back());
+  });
+  pf::bench::run("visit_batch to ordered output, 1M variants", iterations, [&] {
+    pf::visit_batch(shapes, area, areas.begin());
+    pf::bench::do_not_optimize(areas.back());
+  });
+  return 0;
+}
@@ -26,6 +26,11 @@ concept hashable = requires(T t) {
   ->std::convertible_to<std::size_t>;
 };
 
+template<typename E>
+concept executor = requires(E e, std::function<void()> f) {
+  {e.enqueue(f)};
+};
+
 template<typename T>
 concept copy_assignable = std::is_copy_assignable_v<T>;
 
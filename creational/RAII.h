@@ -5,20 +5,158 @@
 #ifndef DESIGN_PATTERNS_RAII_H
 #define DESIGN_PATTERNS_RAII_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace pf {
 class RAII {
  public:
   template<std::invocable F>
   explicit RAII(F &&callable) : callable(std::forward<F>(callable)) {}
+  RAII(const RAII &) = delete;
+  RAII &operator=(const RAII &) = delete;
+  /**
+   * The moved from guard does nothing on destruction.
+   */
+  RAII(RAII &&other) noexcept : callable(std::exchange(other.callable, nullptr)) {}
 
   ~RAII() {
-    std::invoke(callable);
+    if (callable) {
+      std::invoke(callable);
+    }
   }
 
  private:
   std::function<void()> callable;
 };
+
+/**
+ * Epoch based reclamation. Readers pin the current epoch for the lifetime of a guard, objects retired by writers
+ * are freed in batches once every pinned reader has moved past the epoch in which they were retired.
+ */
+class epoch_domain {
+  static constexpr auto inactive = std::numeric_limits<std::uint64_t>::max();
+
+  struct alignas(64) participant {
+    std::atomic<bool> claimed = false;
+    std::atomic<std::uint64_t> epoch = inactive;
+  };
+
+  struct retired {
+    void *object;
+    void (*deleter)(void *);
+  };
+
+ public:
+  /**
+   * @param max_pins maximum number of simultaneously pinned guards
+   * @param batch_size number of retired objects after which reclamation is attempted automatically
+   */
+  explicit epoch_domain(std::size_t max_pins = 128, std::size_t batch_size = 64)
+      : participants(std::make_unique<participant[]>(max_pins)), participant_count(max_pins), batch_size(batch_size) {}
+  epoch_domain(const epoch_domain &) = delete;
+  epoch_domain &operator=(const epoch_domain &) = delete;
+
+  /**
+   * Frees all retired objects, no guard may be alive.
+   */
+  ~epoch_domain() {
+    for (auto &bucket : limbo) {
+      free(bucket);
+    }
+  }
+
+  /**
+   * Objects reachable while the guard is alive are not freed until it is destroyed.
+   */
+  [[nodiscard]] RAII pin() {
+    auto &slot = claim();
+    slot.epoch.store(global_epoch.load());
+    return RAII{[&slot] {
+      slot.epoch.store(inactive, std::memory_order_release);
+      slot.claimed.store(false, std::memory_order_release);
+    }};
+  }
+
+  /**
+   * Deletes object once no reader pinned before this call can access it. object has to be unreachable for new readers.
+   */
+  template<typename T>
+  void retire(T *object) {
+    auto pending = std::size_t{};
+    {
+      std::unique_lock lock{mutex};
+      auto &bucket = limbo[global_epoch.load(std::memory_order_relaxed) % limbo.size()];
+      bucket.emplace_back(object, [](void *ptr) { delete static_cast<T *>(ptr); });
+      pending = ++retired_since_reclaim;
+    }
+    if (pending >= batch_size) {
+      reclaim();
+    }
+  }
+
+  /**
+   * Advances the epoch if all pinned readers are in the current one and frees the batch which became unreachable.
+   * @return number of freed objects
+   */
+  std::size_t reclaim() {
+    auto batch = std::vector<retired>{};
+    {
+      std::unique_lock lock{mutex};
+      retired_since_reclaim = 0;
+      const auto current = global_epoch.load(std::memory_order_relaxed);
+      for (std::size_t i = 0; i < participant_count; ++i) {
+        const auto epoch = participants[i].epoch.load();
+        if (epoch != inactive && epoch != current) {
+          return 0;
+        }
+      }
+      global_epoch.store(current + 1);
+      std::swap(batch, limbo[(current + 1) % limbo.size()]);
+    }
+    free(batch);
+    return batch.size();
+  }
+
+  [[nodiscard]] std::uint64_t epoch() const {
+    return global_epoch.load();
+  }
+
+ private:
+  participant &claim() {
+    const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    while (true) {
+      for (std::size_t i = 0; i < participant_count; ++i) {
+        auto &slot = participants[(start + i) % participant_count];
+        if (!slot.claimed.load(std::memory_order_relaxed) && !slot.claimed.exchange(true, std::memory_order_acquire)) {
+          return slot;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  static void free(std::vector<retired> &batch) {
+    for (const auto &[object, deleter] : batch) {
+      deleter(object);
+    }
+  }
+
+  std::unique_ptr<participant[]> participants;
+  std::size_t participant_count;
+  std::size_t batch_size;
+  std::atomic<std::uint64_t> global_epoch = 0;
+  std::mutex mutex;
+  std::array<std::vector<retired>, 3> limbo;
+  std::size_t retired_since_reclaim = 0;
+};
 }// namespace pf
 #endif//DESIGN_PATTERNS_RAII_H
@@ -5,10 +5,21 @@
 #ifndef DESIGN_PATTERNS_ABSTRACT_FACTORY_H
 #define DESIGN_PATTERNS_ABSTRACT_FACTORY_H
 #include "../concepts.h"
+#include <algorithm>
+#include <array>
 #include <exception>
 #include <functional>
+#include <initializer_list>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace pf {
 template<enum_type E, typename ResultType, typename... Args>
@@ -29,5 +40,359 @@ class abstract_factory {
  private:
   constructor_map constructors;
 };
+
+/**
+ * Number of values of a contiguous enum starting at 0.
+ * Taken from a count sentinel (E::count) or provided by specializing enum_count.
+ */
+template<enum_type E>
+struct enum_count;
+
+template<enum_type E>
+requires requires { E::count; }
+struct enum_count<E> : std::integral_constant<std::size_t, static_cast<std::size_t>(E::count)> {};
+
+template<enum_type E>
+inline constexpr std::size_t enum_count_v = enum_count<E>::value;
+
+template<typename E>
+concept dense_enum = enum_type<E> &&requires {
+  { enum_count<E>::value }
+  ->std::convertible_to<std::size_t>;
+};
+
+namespace details {
+template<dense_enum E, typename Constructor, typename ResultType, typename... Args>
+class dense_abstract_factory_impl {
+ public:
+  using value_type = ResultType;
+  using constructor_type = Constructor;
+  using constructor_table = std::array<constructor_type, enum_count_v<E>>;
+
+  constexpr explicit dense_abstract_factory_impl(std::initializer_list<std::pair<E, constructor_type>> constructors) {
+    for (const auto &[type, constructor] : constructors) {
+      constructors_[index_of(type)] = constructor;
+    }
+  }
+
+  constexpr explicit dense_abstract_factory_impl(constructor_table constructors) : constructors_(std::move(constructors)) {}
+
+  constexpr value_type create(E type, Args &&... args) const {
+    const auto &constructor = constructors_[index_of(type)];
+    if (!constructor) {
+      throw std::invalid_argument("Invalid enum type in abstract_factory.");
+    }
+    return constructor(std::forward<Args>(args)...);
+  }
+
+ private:
+  static constexpr std::size_t index_of(E type) {
+    const auto index = static_cast<std::size_t>(static_cast<std::underlying_type_t<E>>(type));
+    if (index >= enum_count_v<E>) {
+      throw std::invalid_argument("Invalid enum type in abstract_factory.");
+    }
+    return index;
+  }
+
+  constructor_table constructors_{};
+};
+}// namespace details
+
+/**
+ * abstract_factory for contiguous enums, constructors are looked up in an array indexed by the enum value.
+ */
+template<dense_enum E, typename ResultType, typename... Args>
+using dense_abstract_factory = details::dense_abstract_factory_impl<E, std::function<ResultType(Args...)>, ResultType, Args...>;
+
+/**
+ * dense_abstract_factory storing plain function pointers, can be built and used in constant expressions.
+ */
+template<dense_enum E, typename ResultType, typename... Args>
+using constexpr_abstract_factory = details::dense_abstract_factory_impl<E, ResultType (*)(Args...), ResultType, Args...>;
+
+/**
+ * Destroys the concrete product type and returns its memory to the resource it was allocated from,
+ * Base does not need a virtual destructor.
+ */
+template<typename Base>
+struct pooled_deleter {
+  std::pmr::memory_resource *resource = nullptr;
+  void (*destroy)(Base *, std::pmr::memory_resource *) = nullptr;
+
+  void operator()(Base *ptr) const {
+    destroy(ptr, resource);
+  }
+};
+
+template<typename Base>
+using pooled_ptr = std::unique_ptr<Base, pooled_deleter<Base>>;
+
+template<typename Base>
+class product_allocator {
+ public:
+  explicit product_allocator(std::pmr::memory_resource &resource) : resource(&resource) {}
+
+  template<std::derived_from<Base> T, typename... CtorArgs>
+  pooled_ptr<Base> make(CtorArgs &&... args) {
+    void *memory = resource->allocate(sizeof(T), alignof(T));
+    T *object;
+    try {
+      if constexpr (std::is_constructible_v<T, CtorArgs...>) {
+        object = new (memory) T(std::forward<CtorArgs>(args)...);
+      } else {
+        object = new (memory) T{std::forward<CtorArgs>(args)...};
+      }
+    } catch (...) {
+      resource->deallocate(memory, sizeof(T), alignof(T));
+      throw;
+    }
+    return pooled_ptr<Base>(object, pooled_deleter<Base>{resource, &destroy<T>});
+  }
+
+ private:
+  template<typename T>
+  static void destroy(Base *ptr, std::pmr::memory_resource *resource) {
+    auto object = static_cast<T *>(ptr);
+    object->~T();
+    resource->deallocate(object, sizeof(T), alignof(T));
+  }
+
+  std::pmr::memory_resource *resource;
+};
+
+/**
+ * abstract_factory constructing products in a memory resource, either a caller supplied arena
+ * or by default its own synchronized pool resource with a pool per allocation size.
+ * Products must not outlive the memory resource. With the default resource create may be called and products
+ * destroyed from any thread, a caller supplied resource has to be thread safe for that too.
+ */
+template<enum_type E, typename Base, typename... Args>
+class pooled_abstract_factory {
+ public:
+  using value_type = pooled_ptr<Base>;
+  using constructor_map = std::unordered_map<E, std::function<value_type(product_allocator<Base>, Args...)>>;
+
+  explicit pooled_abstract_factory(constructor_map &&constructors)
+      : constructors(std::move(constructors)), owned_resource(std::make_unique<std::pmr::synchronized_pool_resource>()),
+        resource(owned_resource.get()) {}
+
+  pooled_abstract_factory(constructor_map &&constructors, std::pmr::memory_resource &resource)
+      : constructors(std::move(constructors)), resource(&resource) {}
+
+  value_type create(E type, Args &&... args) {
+    if (const auto iter = constructors.find(type); iter != constructors.end()) {
+      return iter->second(product_allocator<Base>{*resource}, std::forward<Args>(args)...);
+    }
+    throw std::invalid_argument("Invalid enum type in abstract_factory.");
+  }
+
+  [[nodiscard]] std::pmr::memory_resource &get_resource() const {
+    return *resource;
+  }
+
+ private:
+  constructor_map constructors;
+  std::unique_ptr<std::pmr::memory_resource> owned_resource;
+  std::pmr::memory_resource *resource;
+};
+
+/**
+ * Forwards to an upstream resource and counts allocations, for measuring how many allocations reach the upstream.
+ */
+class counting_memory_resource : public std::pmr::memory_resource {
+ public:
+  explicit counting_memory_resource(std::pmr::memory_resource &upstream = *std::pmr::get_default_resource()) : upstream(&upstream) {}
+
+  [[nodiscard]] std::size_t allocation_count() const {
+    return allocations;
+  }
+
+  [[nodiscard]] std::size_t deallocation_count() const {
+    return deallocations;
+  }
+
+  [[nodiscard]] std::size_t allocated_bytes() const {
+    return bytes;
+  }
+
+ private:
+  void *do_allocate(std::size_t size, std::size_t alignment) override {
+    ++allocations;
+    bytes += size;
+    return upstream->allocate(size, alignment);
+  }
+
+  void do_deallocate(void *ptr, std::size_t size, std::size_t alignment) override {
+    ++deallocations;
+    upstream->deallocate(ptr, size, alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource *upstream;
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytes = 0;
+};
+
+/**
+ * Constructs T directly from the given arguments, the default product_type constructor.
+ */
+template<typename T>
+struct direct_constructor {
+  template<typename... Args>
+  requires std::constructible_from<T, Args...>
+  T operator()(Args &&... args) const {
+    return T(std::forward<Args>(args)...);
+  }
+};
+
+/**
+ * Binds an enum value to the concrete type constructed for it and the callable constructing it.
+ */
+template<auto Value, typename T, typename Constructor = direct_constructor<T>>
+struct product_type {
+  static constexpr auto value = Value;
+  using type = T;
+  using constructor = Constructor;
+};
+
+namespace details {
+template<typename Product, typename Request, typename Indices>
+struct product_constructible_from_request;
+
+template<typename Product, typename Request, std::size_t... Is>
+struct product_constructible_from_request<Product, Request, std::index_sequence<Is...>> {
+  static constexpr bool value = [] {
+    if constexpr (std::invocable<const typename Product::constructor &, const std::tuple_element_t<Is + 1, Request> &...>) {
+      return std::constructible_from<typename Product::type, std::invoke_result_t<const typename Product::constructor &, const std::tuple_element_t<Is + 1, Request> &...>>;
+    } else {
+      return false;
+    }
+  }();
+};
+
+/**
+ * Every product can be constructed from the constructor arguments of a tuple-like Request.
+ */
+template<typename Request, typename... Products>
+concept batch_request = (product_constructible_from_request<Products, Request, std::make_index_sequence<std::tuple_size_v<Request> - 1>>::value && ...);
+}// namespace details
+
+/**
+ * Products created by batch_abstract_factory::create_n. Each product type is stored in its own contiguous buffer,
+ * items() gives a polymorphic view in request order.
+ */
+template<typename Base, typename... Products>
+class product_batch {
+  template<enum_type E, typename B, typename... Ps>
+  friend class batch_abstract_factory;
+  static constexpr std::array values{Products::value...};
+
+ public:
+  product_batch() = default;
+  product_batch(product_batch &&) noexcept = default;
+  product_batch &operator=(product_batch &&) noexcept = default;
+  product_batch(const product_batch &) = delete;
+  product_batch &operator=(const product_batch &) = delete;
+
+  [[nodiscard]] std::span<Base *const> items() const {
+    return views;
+  }
+
+  [[nodiscard]] std::size_t size() const {
+    return views.size();
+  }
+
+  template<auto Value>
+  [[nodiscard]] auto products() {
+    return std::span{std::get<index_of<Value>()>(storage)};
+  }
+
+  /**
+   * Calls f with a span of each product type, letting f work on homogeneous runs without virtual dispatch.
+   */
+  void for_each_run(auto &&f) {
+    std::apply([&f](auto &... buffers) { (f(std::span{buffers}), ...); }, storage);
+  }
+
+ private:
+  template<auto Value>
+  static constexpr std::size_t index_of() {
+    constexpr auto iter = std::find(values.begin(), values.end(), Value);
+    static_assert(iter != values.end(), "Value has no product in product_batch.");
+    return iter - values.begin();
+  }
+
+  std::tuple<std::vector<typename Products::type>...> storage;
+  std::vector<Base *> views;
+};
+
+/**
+ * Factory whose products are known at compile time, which lets create_n construct them grouped by type.
+ */
+template<enum_type E, typename Base, typename... Products>
+requires((std::derived_from<typename Products::type, Base> && std::same_as<std::remove_cv_t<decltype(Products::value)>, E>) &&...)
+class batch_abstract_factory {
+  static constexpr std::array<E, sizeof...(Products)> values{Products::value...};
+
+ public:
+  using batch_type = product_batch<Base, Products...>;
+
+  batch_abstract_factory() requires(std::default_initializable<typename Products::constructor> &&...) = default;
+
+  explicit batch_abstract_factory(typename Products::constructor... constructors) : constructors(std::move(constructors)...) {}
+
+  /**
+   * @param requests range of tuple-like items, the first element is the enum value and the rest are arguments
+   * passed to the product's constructor
+   */
+  template<std::ranges::forward_range R>
+  requires details::batch_request<std::ranges::range_value_t<R>, Products...>
+  batch_type create_n(R &&requests) const {
+    auto counts = std::array<std::size_t, sizeof...(Products)>{};
+    std::size_t total = 0;
+    for (const auto &request : requests) {
+      ++counts[index_of(std::get<0>(request))];
+      ++total;
+    }
+    auto batch = batch_type{};
+    batch.views.reserve(total);
+    reserve(batch, counts, std::index_sequence_for<Products...>{});
+    for (const auto &request : requests) {
+      std::apply([&](E type, const auto &... args) {
+        emplace(batch, index_of(type), std::index_sequence_for<Products...>{}, args...);
+      }, request);
+    }
+    return batch;
+  }
+
+ private:
+  static std::size_t index_of(E type) {
+    if (const auto iter = std::find(values.begin(), values.end(), type); iter != values.end()) {
+      return iter - values.begin();
+    }
+    throw std::invalid_argument("Invalid enum type in abstract_factory.");
+  }
+
+  template<std::size_t... Is>
+  static void reserve(batch_type &batch, const std::array<std::size_t, sizeof...(Products)> &counts, std::index_sequence<Is...>) {
+    (std::get<Is>(batch.storage).reserve(counts[Is]), ...);
+  }
+
+  template<std::size_t... Is, typename... CtorArgs>
+  void emplace(batch_type &batch, std::size_t index, std::index_sequence<Is...>, const CtorArgs &... args) const {
+    ((Is == index && (emplace_at<Is>(batch, args...), true)) || ...);
+  }
+
+  template<std::size_t I, typename... CtorArgs>
+  void emplace_at(batch_type &batch, const CtorArgs &... args) const {
+    batch.views.emplace_back(&std::get<I>(batch.storage).emplace_back(std::invoke(std::get<I>(constructors), args...)));
+  }
+
+  std::tuple<typename Products::constructor...> constructors;
+};
 }// namespace pf
 #endif//DESIGN_PATTERNS_ABSTRACT_FACTORY_H
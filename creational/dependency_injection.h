@@ -5,7 +5,14 @@
 #ifndef DESIGN_PATTERNS_DEPENDENCY_INJECTION_H
 #define DESIGN_PATTERNS_DEPENDENCY_INJECTION_H
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
 #include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace pf {
 template<typename T>
@@ -62,5 +69,84 @@ class dependency {
  private:
   std::optional<value_type> value = std::nullopt;
 };
+
+/**
+ * Binding for pf::injector, T is constructed from references to its Dependencies.
+ */
+template<typename T, typename... Dependencies>
+struct bind {
+  using interface_type = T;
+  using type = T;
+  using dependencies = std::tuple<Dependencies...>;
+};
+
+/**
+ * Binding for pf::injector, T is constructed from references to its Dependencies and resolved as Interface.
+ */
+template<typename Interface, typename T, typename... Dependencies>
+requires std::derived_from<T, Interface>
+struct bind_as : bind<T, Dependencies...> {
+  using interface_type = Interface;
+};
+
+namespace details {
+template<typename T, typename... Bindings>
+constexpr std::size_t binding_index() {
+  constexpr std::array matches{(std::is_same_v<T, typename Bindings::interface_type> || std::is_same_v<T, typename Bindings::type>)...};
+  static_assert(std::count(matches.begin(), matches.end(), true) == 1, "Type has to be bound exactly once in injector.");
+  return std::find(matches.begin(), matches.end(), true) - matches.begin();
+}
+
+template<std::size_t I, typename Dependencies, typename... Bindings>
+struct bound_before;
+template<std::size_t I, typename... Dependencies, typename... Bindings>
+struct bound_before<I, std::tuple<Dependencies...>, Bindings...>
+    : std::bool_constant<((binding_index<Dependencies, Bindings...>() < I) && ...)> {};
+
+template<std::size_t I, typename Binding>
+struct injector_slot {
+  template<typename Injector, typename... Dependencies>
+  injector_slot(Injector &injector, std::tuple<Dependencies...> *) : value(injector.template get<Dependencies>()...) {}
+  typename Binding::type value;
+};
+
+template<typename Indices, typename... Bindings>
+class injector_storage;
+
+/**
+ * Slots are base subobjects, which are constructed in the order of the base list, so a slot can be built from
+ * references to slots before it.
+ */
+template<std::size_t... Is, typename... Bindings>
+class injector_storage<std::index_sequence<Is...>, Bindings...> : injector_slot<Is, Bindings>... {
+ public:
+  injector_storage() : injector_slot<Is, Bindings>(*this, static_cast<typename Bindings::dependencies *>(nullptr))... {
+    static_assert((bound_before<Is, typename Bindings::dependencies, Bindings...>::value && ...),
+                  "Dependencies have to be bound before their dependents.");
+  }
+  injector_storage(const injector_storage &) = delete;
+  injector_storage &operator=(const injector_storage &) = delete;
+
+  template<typename T>
+  [[nodiscard]] T &get() {
+    constexpr auto index = binding_index<T, Bindings...>();
+    return static_cast<injector_slot<index, std::tuple_element_t<index, std::tuple<Bindings...>>> &>(*this).value;
+  }
+
+  template<typename T>
+  [[nodiscard]] const T &get() const {
+    constexpr auto index = binding_index<T, Bindings...>();
+    return static_cast<const injector_slot<index, std::tuple_element_t<index, std::tuple<Bindings...>>> &>(*this).value;
+  }
+};
+}// namespace details
+
+/**
+ * Dependency injection container resolved at compile time. Bindings are constructed in the listed order,
+ * each from references to its already constructed dependencies. get<T>() is a plain member access.
+ * pf::injector<pf::bind<Config>, pf::bind_as<Logger, FileLogger, Config>, pf::bind<Service, Logger, Config>>
+ */
+template<typename... Bindings>
+class injector : public details::injector_storage<std::index_sequence_for<Bindings...>, Bindings...> {};
 }// namespace pf
 #endif//DESIGN_PATTERNS_DEPENDENCY_INJECTION_H
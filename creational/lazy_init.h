@@ -6,7 +6,15 @@
 #define DESIGN_PATTERNS_LAZY_INIT_H
 
 #include "../concepts.h"
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 namespace pf {
 template<typename T>
@@ -33,7 +41,7 @@ class lazy_init {
 
   const_pointer operator->() const {
     calculate();
-    return *&value;
+    return &*value;
   }
 
   const_reference operator*() const {
@@ -41,14 +49,366 @@ class lazy_init {
     return *value;
   }
 
+ protected:
+  void reset() const {
+    value.reset();
+  }
+
  private:
-  void calculate() {
+  void calculate() const {
     if (value == nullptr) {
       value = std::make_unique<T>(calc());
     }
   }
-  calc_fnc calc;
-  std::unique_ptr<T> value;
+  mutable calc_fnc calc;
+  mutable std::unique_ptr<T> value;
+};
+
+enum class lazy_wait {
+  block,
+  spin
+};
+
+/**
+ * Thread safe lazy_init storing the value inline. Once initialized an access costs a single acquire load.
+ * Concurrent first callers wait for the one computing the value, either blocking on the atomic or spinning.
+ * If the calculation throws, the value stays uninitialized and the next access retries.
+ */
+template<typename T, std::invocable Calc = std::function<T()>, lazy_wait Wait = lazy_wait::block>
+class concurrent_lazy_init {
+  enum class state : unsigned char {
+    empty,
+    computing,
+    ready
+  };
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  explicit concurrent_lazy_init(Calc calc) : calc(std::move(calc)) {}
+
+  /**
+   * Starts the calculation on executor right away, see prefetch.
+   */
+  concurrent_lazy_init(Calc calc, executor auto &executor) : calc(std::move(calc)) {
+    prefetch(executor);
+  }
+
+  concurrent_lazy_init(const concurrent_lazy_init &) = delete;
+  concurrent_lazy_init &operator=(const concurrent_lazy_init &) = delete;
+  concurrent_lazy_init(concurrent_lazy_init &&) = delete;
+  concurrent_lazy_init &operator=(concurrent_lazy_init &&) = delete;
+
+  ~concurrent_lazy_init() {
+    while (prefetch_pending->load(std::memory_order_acquire)) {
+      prefetch_pending->wait(true, std::memory_order_acquire);
+    }
+    if (current_state.load(std::memory_order_acquire) == state::ready) {
+      std::destroy_at(value_ptr());
+    }
+  }
+
+  pointer operator->() {
+    calculate();
+    return value_ptr();
+  }
+
+  reference operator*() {
+    calculate();
+    return *value_ptr();
+  }
+
+  const_pointer operator->() const {
+    calculate();
+    return value_ptr();
+  }
+
+  const_reference operator*() const {
+    calculate();
+    return *value_ptr();
+  }
+
+  /**
+   * Computes the value on executor in the background, an access made meanwhile waits only for the rest of the calculation.
+   * Does nothing if the value is already being computed. The destructor waits for the prefetch task to finish,
+   * so executor has to run it.
+   */
+  void prefetch(executor auto &executor) {
+    if (current_state.load(std::memory_order_acquire) != state::empty || prefetch_pending->exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    // the task keeps its own reference to the flag, the object may be gone as soon as the flag is cleared
+    executor.enqueue([this, pending = prefetch_pending] {
+      try {
+        try_calculate();
+      } catch (...) {
+      }
+      pending->store(false, std::memory_order_release);
+      pending->notify_all();
+    });
+  }
+
+  [[nodiscard]] bool is_initialized() const {
+    return current_state.load(std::memory_order_acquire) == state::ready;
+  }
+
+ private:
+  void calculate() const {
+    if (current_state.load(std::memory_order_acquire) != state::ready) {
+      calculate_slow();
+    }
+  }
+
+  /**
+   * Computes the value if nobody else does, never waits.
+   */
+  void try_calculate() const {
+    auto expected = state::empty;
+    if (current_state.compare_exchange_strong(expected, state::computing, std::memory_order_acquire)) {
+      compute();
+    }
+  }
+
+  void compute() const {
+    try {
+      std::construct_at(value_ptr(), std::invoke(calc));
+    } catch (...) {
+      current_state.store(state::empty, std::memory_order_release);
+      current_state.notify_all();
+      throw;
+    }
+    current_state.store(state::ready, std::memory_order_release);
+    current_state.notify_all();
+  }
+
+  void calculate_slow() const {
+    auto expected = current_state.load(std::memory_order_acquire);
+    while (expected != state::ready) {
+      if (expected == state::empty) {
+        if (current_state.compare_exchange_weak(expected, state::computing, std::memory_order_acquire)) {
+          compute();
+          return;
+        }
+        continue;
+      }
+      if constexpr (Wait == lazy_wait::block) {
+        current_state.wait(state::computing, std::memory_order_acquire);
+      } else {
+        std::this_thread::yield();
+      }
+      expected = current_state.load(std::memory_order_acquire);
+    }
+  }
+
+  pointer value_ptr() const {
+    return std::launder(reinterpret_cast<pointer>(storage));
+  }
+
+  mutable Calc calc;
+  mutable std::atomic<state> current_state = state::empty;
+  std::shared_ptr<std::atomic<bool>> prefetch_pending = std::make_shared<std::atomic<bool>>(false);
+  alignas(T) mutable std::byte storage[sizeof(T)];
+};
+
+template<std::invocable Calc>
+concurrent_lazy_init(Calc) -> concurrent_lazy_init<std::invoke_result_t<Calc>, Calc>;
+
+/**
+ * Node of a dependency graph of computed values. Invalidating a node marks all of its transitive dependents dirty,
+ * stopping at nodes which are dirty already. Dependencies have to outlive their dependents. Not thread safe.
+ */
+class computation_node {
+ public:
+  computation_node() = default;
+  computation_node(const computation_node &) = delete;
+  computation_node &operator=(const computation_node &) = delete;
+  computation_node(computation_node &&) = delete;
+  computation_node &operator=(computation_node &&) = delete;
+
+  virtual ~computation_node() {
+    for (auto dependency : dependencies) {
+      std::erase(dependency->dependents, this);
+    }
+    for (auto dependent : dependents) {
+      std::erase(dependent->dependencies, this);
+    }
+  }
+
+  /**
+   * @throws std::logic_error if the dependency would create a cycle
+   */
+  void depends_on(computation_node &dependency) {
+    // a node nothing depends on yet can only close a cycle with itself
+    if (&dependency == this || (!dependents.empty() && dependency.reaches(this))) {
+      throw std::logic_error("Dependency cycle in computation graph.");
+    }
+    dependencies.emplace_back(&dependency);
+    dependency.dependents.emplace_back(this);
+    invalidate();
+  }
+
+  void invalidate() {
+    if (!dirty) {
+      dirty = true;
+      on_invalidate();
+    }
+    invalidate_dependents();
+  }
+
+  [[nodiscard]] bool is_dirty() const {
+    return dirty;
+  }
+
+ protected:
+  explicit computation_node(bool dirty) : dirty(dirty) {}
+
+  virtual void on_invalidate() {}
+
+  void invalidate_dependents() {
+    auto pending = dependents;
+    while (!pending.empty()) {
+      const auto node = pending.back();
+      pending.pop_back();
+      if (!node->dirty) {
+        node->dirty = true;
+        node->on_invalidate();
+        pending.insert(pending.end(), node->dependents.begin(), node->dependents.end());
+      }
+    }
+  }
+
+  mutable bool dirty = true;
+
+ private:
+  [[nodiscard]] bool reaches(const computation_node *target) const {
+    auto visited = std::unordered_set<const computation_node *>{this};
+    auto stack = std::vector<const computation_node *>{this};
+    while (!stack.empty()) {
+      const auto node = stack.back();
+      stack.pop_back();
+      if (node == target) {
+        return true;
+      }
+      for (const auto dependency : node->dependencies) {
+        if (visited.insert(dependency).second) {
+          stack.emplace_back(dependency);
+        }
+      }
+    }
+    return false;
+  }
+
+  std::vector<computation_node *> dependencies;
+  std::vector<computation_node *> dependents;
+};
+
+/**
+ * Source value of a computation graph, set() invalidates everything computed from it.
+ */
+template<typename T>
+class input_node : public computation_node {
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using const_pointer = const T *;
+
+  explicit input_node(T value) : computation_node(false), value(std::move(value)) {}
+
+  void set(T new_value) {
+    value = std::move(new_value);
+    invalidate_dependents();
+  }
+
+  const_pointer operator->() const {
+    return &value;
+  }
+
+  const_reference operator*() const {
+    return value;
+  }
+
+ private:
+  T value;
+};
+
+/**
+ * lazy_init computed from other nodes. Access recomputes the value only when it is stale, recursively refreshing
+ * stale dependencies first.
+ */
+template<typename T>
+class computed : public lazy_init<T>, public computation_node {
+ public:
+  using typename lazy_init<T>::reference;
+  using typename lazy_init<T>::const_reference;
+  using typename lazy_init<T>::pointer;
+  using typename lazy_init<T>::const_pointer;
+
+  template<typename F, std::derived_from<computation_node>... Deps>
+  requires std::invocable<F &, decltype(*std::declval<Deps &>())...>
+  explicit computed(F calc, Deps &... deps)
+      : lazy_init<T>([this, calc = std::move(calc), &deps...]() mutable {
+          ++evaluation_count;
+          return std::invoke(calc, *deps...);
+        }) {
+    (depends_on(deps), ...);
+  }
+
+  pointer operator->() {
+    refresh();
+    return lazy_init<T>::operator->();
+  }
+
+  reference operator*() {
+    refresh();
+    return lazy_init<T>::operator*();
+  }
+
+  const_pointer operator->() const {
+    refresh();
+    return lazy_init<T>::operator->();
+  }
+
+  const_reference operator*() const {
+    refresh();
+    return lazy_init<T>::operator*();
+  }
+
+  /**
+   * @return how many times the value was calculated
+   */
+  [[nodiscard]] std::size_t evaluations() const {
+    return evaluation_count;
+  }
+
+ private:
+  void refresh() const {
+    if (evaluating) {
+      throw std::logic_error("Dependency cycle in computation graph.");
+    }
+    if (dirty) {
+      evaluating = true;
+      try {
+        lazy_init<T>::reset();
+        lazy_init<T>::operator*();
+      } catch (...) {
+        evaluating = false;
+        throw;
+      }
+      evaluating = false;
+      dirty = false;
+    }
+  }
+
+  void on_invalidate() override {
+    lazy_init<T>::reset();
+  }
+
+  mutable bool evaluating = false;
+  std::size_t evaluation_count = 0;
 };
 }// namespace pf
 #endif//DESIGN_PATTERNS_LAZY_INIT_H
@@ -6,8 +6,16 @@
 #define DESIGN_PATTERNS_MULTITON_H
 
 #include "../concepts.h"
+#include <array>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace pf {
 template<hashable H, typename T, invocable_returning<T, H> Creator>
@@ -27,12 +35,48 @@ class multiton {
   multiton(const multiton &) = delete;
   multiton &operator=(const multiton &) = delete;
 
+  /**
+   * Thread safe. Lookup of an existing instance takes no lock, an instance is created exactly once per key.
+   * Creator runs without holding any lock, so it may request instances of other keys.
+   */
   static multiton &get_instance(key_type h) {
-    if (auto iter = instances.find(h); iter != instances.end()) {
-      return *iter->second;
+    const auto hash = std::hash<key_type>{}(h);
+    auto &shard = shards[hash % shard_count];
+    if (auto found = find(shard.current.load(std::memory_order_acquire), h, hash); found != nullptr) {
+      return *found;
     }
-    instances[h] = std::unique_ptr<multiton>(new multiton{h});
-    return *instances[h];
+    std::unique_lock lock{shard.mutex};
+    if (auto found = find(shard.current.load(std::memory_order_relaxed), h, hash); found != nullptr) {
+      return *found;
+    }
+    if (auto iter = shard.in_flight.find(h); iter != shard.in_flight.end()) {
+      auto creation = iter->second;
+      lock.unlock();
+      return creation.get();
+    }
+    auto promise = std::promise<multiton &>{};
+    shard.in_flight.emplace(h, promise.get_future().share());
+    lock.unlock();
+    return create(shard, h, hash, promise);
+  }
+
+  /**
+   * Creates the instance on executor. Concurrent calls for a key share one creation and its result,
+   * a failed creation is reported to all of its waiters and the next call tries again.
+   */
+  static std::shared_future<multiton &> get_instance_async(key_type h, executor auto &executor) {
+    return get_instance_async(std::move(h), [&executor](std::function<void()> task) {
+      executor.enqueue(std::move(task));
+    });
+  }
+
+  /**
+   * Same as get_instance_async(h, executor), the creation runs on a detached thread.
+   */
+  static std::shared_future<multiton &> get_instance_async(key_type h) {
+    return get_instance_async(std::move(h), [](std::function<void()> task) {
+      std::thread(std::move(task)).detach();
+    });
   }
 
   pointer operator->() {
@@ -52,11 +96,286 @@ class multiton {
   }
 
  private:
-  static inline std::unordered_map<key_type, std::unique_ptr<multiton>> instances;
-  static inline std::optional<std::function<value_type(key_type)>> instance_creator = std::nullopt;
+  static constexpr std::size_t shard_count = 16;
+
+  struct node {
+    key_type key;
+    std::size_t hash;
+    multiton *instance;
+    node *next;
+  };
+
+  struct bucket_table {
+    explicit bucket_table(std::size_t size) : buckets(size) {}
+    std::vector<std::atomic<node *>> buckets;
+  };
+
+  /**
+   * Readers walk the current table without locking. Nodes are never modified after being published
+   * and replaced tables are kept alive, so a reader holding an old table stays valid.
+   */
+  struct shard {
+    std::atomic<bucket_table *> current = nullptr;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<bucket_table>> tables;
+    std::vector<std::unique_ptr<node>> nodes;
+    std::vector<std::unique_ptr<multiton>> instances;
+    std::unordered_map<key_type, std::shared_future<multiton &>> in_flight;
+  };
+
+  static std::shared_future<multiton &> get_instance_async(key_type h, std::invocable<std::function<void()>> auto &&launch) {
+    const auto hash = std::hash<key_type>{}(h);
+    auto &shard = shards[hash % shard_count];
+    auto promise = std::make_shared<std::promise<multiton &>>();
+    if (auto found = find(shard.current.load(std::memory_order_acquire), h, hash); found != nullptr) {
+      promise->set_value(*found);
+      return promise->get_future().share();
+    }
+    std::unique_lock lock{shard.mutex};
+    if (auto found = find(shard.current.load(std::memory_order_relaxed), h, hash); found != nullptr) {
+      promise->set_value(*found);
+      return promise->get_future().share();
+    }
+    if (auto iter = shard.in_flight.find(h); iter != shard.in_flight.end()) {
+      return iter->second;
+    }
+    auto result = shard.in_flight.emplace(h, promise->get_future().share()).first->second;
+    lock.unlock();
+    launch([h, hash, promise, &shard] {
+      try {
+        create(shard, h, hash, *promise);
+      } catch (...) {
+        // reported through promise
+      }
+    });
+    return result;
+  }
+
+  /**
+   * Creates the instance registered in s.in_flight without holding s.mutex and publishes it.
+   * The result or failure is also passed to promise.
+   */
+  static multiton &create(shard &s, const key_type &h, std::size_t hash, std::promise<multiton &> &promise) {
+    auto instance = std::unique_ptr<multiton>{};
+    try {
+      instance.reset(new multiton{h});
+    } catch (...) {
+      std::unique_lock lock{s.mutex};
+      s.in_flight.erase(h);
+      promise.set_exception(std::current_exception());
+      throw;
+    }
+    std::unique_lock lock{s.mutex};
+    s.in_flight.erase(h);
+    auto &result = publish(s, h, hash, std::move(instance));
+    promise.set_value(result);
+    return result;
+  }
+
+  /**
+   * Registers a new instance, shard.mutex has to be held.
+   */
+  static multiton &publish(shard &s, const key_type &h, std::size_t hash, std::unique_ptr<multiton> new_instance) {
+    auto table = s.current.load(std::memory_order_relaxed);
+    auto &instance = s.instances.emplace_back(std::move(new_instance));
+    if (table == nullptr || s.instances.size() > table->buckets.size()) {
+      table = grow(s, table);
+    }
+    insert(s, *table, h, hash, instance.get());
+    s.current.store(table, std::memory_order_release);
+    return *instance;
+  }
+
+  static multiton *find(bucket_table *table, const key_type &h, std::size_t hash) {
+    if (table == nullptr) {
+      return nullptr;
+    }
+    const auto &bucket = table->buckets[(hash / shard_count) % table->buckets.size()];
+    for (auto n = bucket.load(std::memory_order_acquire); n != nullptr; n = n->next) {
+      if (n->hash == hash && n->key == h) {
+        return n->instance;
+      }
+    }
+    return nullptr;
+  }
+
+  static void insert(shard &s, bucket_table &table, const key_type &h, std::size_t hash, multiton *instance) {
+    auto &bucket = table.buckets[(hash / shard_count) % table.buckets.size()];
+    auto &n = s.nodes.emplace_back(new node{h, hash, instance, bucket.load(std::memory_order_relaxed)});
+    bucket.store(n.get(), std::memory_order_release);
+  }
+
+  static bucket_table *grow(shard &s, bucket_table *old_table) {
+    const auto size = old_table == nullptr ? 8 : old_table->buckets.size() * 2;
+    auto table = s.tables.emplace_back(std::make_unique<bucket_table>(size)).get();
+    if (old_table != nullptr) {
+      for (const auto &bucket : old_table->buckets) {
+        for (auto n = bucket.load(std::memory_order_relaxed); n != nullptr; n = n->next) {
+          insert(s, *table, n->key, n->hash, n->instance);
+        }
+      }
+    }
+    return table;
+  }
+
+  static inline std::array<shard, shard_count> shards;
   value_type value;
 
   explicit multiton(key_type h) : value(Creator{}(h)) {}
 };
+
+enum class eviction_policy {
+  lru,
+  clock
+};
+
+struct unit_cost {
+  template<typename T>
+  std::size_t operator()(const T &) const {
+    return 1;
+  }
+};
+
+struct cache_stats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+};
+
+/**
+ * multiton keeping at most capacity worth of instances, capacity is in entries by default or in units returned by Cost.
+ * Instances are handed out as shared handles, an instance whose handle is still held is never evicted,
+ * so there is at most one live instance per key. The capacity can be exceeded while all instances are in use.
+ */
+template<hashable H, typename T, invocable_returning<T, H> Creator, eviction_policy Policy = eviction_policy::lru, invocable_returning<std::size_t, const T &> Cost = unit_cost>
+class bounded_multiton {
+ public:
+  using key_type = H;
+  using value_type = T;
+  using handle = std::shared_ptr<T>;
+
+  bounded_multiton() = delete;
+
+  /**
+   * Thread safe. Creator runs without holding the lock, so it may request instances of other keys,
+   * concurrent calls for a key being created wait for that creation and count as hits.
+   */
+  static handle get_instance(const key_type &h) {
+    std::unique_lock lock{mutex};
+    if (auto iter = index.find(h); iter != index.end()) {
+      ++stats_.hits;
+      if constexpr (Policy == eviction_policy::lru) {
+        entries.splice(entries.begin(), entries, iter->second);
+      } else {
+        iter->second->referenced = true;
+      }
+      return iter->second->instance;
+    }
+    if (auto iter = in_flight.find(h); iter != in_flight.end()) {
+      ++stats_.hits;
+      auto creation = iter->second;
+      lock.unlock();
+      return creation.get();
+    }
+    ++stats_.misses;
+    auto promise = std::promise<handle>{};
+    in_flight.emplace(h, promise.get_future().share());
+    lock.unlock();
+    auto instance = handle{};
+    auto cost = std::size_t{};
+    try {
+      instance = std::make_shared<T>(Creator{}(h));
+      cost = Cost{}(*instance);
+    } catch (...) {
+      lock.lock();
+      in_flight.erase(h);
+      promise.set_exception(std::current_exception());
+      throw;
+    }
+    lock.lock();
+    in_flight.erase(h);
+    const auto position = Policy == eviction_policy::lru ? entries.begin() : entries.end();
+    index.emplace(h, entries.emplace(position, h, instance, cost));
+    total_cost += cost;
+    evict();
+    promise.set_value(instance);
+    return instance;
+  }
+
+  static void set_capacity(std::size_t capacity) {
+    std::unique_lock lock{mutex};
+    bounded_multiton::capacity = capacity;
+    evict();
+  }
+
+  [[nodiscard]] static std::size_t size() {
+    std::unique_lock lock{mutex};
+    return entries.size();
+  }
+
+  [[nodiscard]] static cache_stats stats() {
+    std::unique_lock lock{mutex};
+    return stats_;
+  }
+
+ private:
+  struct entry {
+    entry(key_type key, handle instance, std::size_t cost) : key(std::move(key)), instance(std::move(instance)), cost(cost) {}
+    key_type key;
+    handle instance;
+    std::size_t cost;
+    bool referenced = false;
+  };
+  using entry_iterator = typename std::list<entry>::iterator;
+
+  static bool in_use(const entry &e) {
+    return e.instance.use_count() > 1;
+  }
+
+  static void evict() {
+    while (total_cost > capacity) {
+      auto victim = find_victim();
+      if (victim == entries.end()) {
+        return;
+      }
+      total_cost -= victim->cost;
+      index.erase(victim->key);
+      entries.erase(victim);
+      ++stats_.evictions;
+    }
+  }
+
+  static entry_iterator find_victim() {
+    if constexpr (Policy == eviction_policy::lru) {
+      for (auto iter = entries.rbegin(); iter != entries.rend(); ++iter) {
+        if (!in_use(*iter)) {
+          return std::prev(iter.base());
+        }
+      }
+      return entries.end();
+    } else {
+      // the front of entries acts as the clock hand, passed entries are moved to the back
+      for (std::size_t step = 0; step < 2 * entries.size(); ++step) {
+        const auto hand = entries.begin();
+        if (!in_use(*hand)) {
+          if (!hand->referenced) {
+            return hand;
+          }
+          hand->referenced = false;
+        }
+        entries.splice(entries.end(), entries, hand);
+      }
+      return entries.end();
+    }
+  }
+
+  static inline std::mutex mutex;
+  static inline std::list<entry> entries;
+  static inline std::unordered_map<key_type, entry_iterator> index;
+  static inline std::unordered_map<key_type, std::shared_future<handle>> in_flight;
+  static inline std::size_t capacity = std::numeric_limits<std::size_t>::max();
+  static inline std::size_t total_cost = 0;
+  static inline cache_stats stats_;
+};
 }// namespace pf
 #endif//DESIGN_PATTERNS_MULTITON_H
@@ -9,7 +9,6 @@
 #include <algorithm>
 #include <concepts>
 #include <exception>
-#include <iostream>
 #include <list>
 #include <mutex>
 #include <experimental/memory>
@@ -75,7 +74,6 @@ struct default_pool_allocator {
 
   void alloc_n(std::list<std::unique_ptr<T>> &available, std::list<std::unique_ptr<T>> &in_use, std::size_t n) {
     std::generate_n(std::back_inserter(available), n, [&] { return std::make_unique<T>(generator()); });
-    std::cout << "allocating " << n << std::endl;
   }
 
   std::function<T()> generator;
@@ -99,10 +97,20 @@ class object_pool {
   }
 
   [[nodiscard]] pointer lease() {
+    if (auto result = try_lease(); result != nullptr) {
+      return result;
+    }
+    throw std::runtime_error{"Pool has no available objects."};
+  }
+
+  /**
+   * @return nullptr if the pool has no available objects
+   */
+  [[nodiscard]] pointer try_lease() {
     std::unique_lock lock{mutex};
     allocator.on_lease(available_, in_use);
     if (available_.empty()) {
-      throw std::runtime_error{"Pool has no available objects."};
+      return nullptr;
     }
     const auto first_available_iter = available_.begin();
     auto &ref = in_use.emplace_front(std::move(*first_available_iter));
@@ -6,8 +6,95 @@
 #define DESIGN_PATTERNS_PROTOTYPE_H
 
 #include "../concepts.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace pf {
+namespace details {
+template<copyable T>
+struct cow_block {
+  explicit cow_block(const T &source) requires(std::copy_constructible<T>) : value(source) {}
+  explicit cow_block(const T &source) requires(!std::copy_constructible<T>) {
+    value = source;
+  }
+  std::atomic<std::size_t> references = 1;
+  T value;
+};
+
+template<typename It, typename T>
+concept contiguous_iterator_of = std::contiguous_iterator<It> && std::same_as<std::iter_value_t<It>, T>;
+}// namespace details
+
+/**
+ * Handle sharing an immutable instance with other handles, the instance is copied on the first mutable access
+ * while it is shared. Reference counting is atomic, a single handle must not be used by multiple threads at once.
+ */
+template<copyable T>
+class cow {
+  template<copyable>
+  friend class prototype;
+
+ public:
+  cow(const cow &other) noexcept : block(other.block) {
+    if (block != nullptr) {
+      block->references.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  cow(cow &&other) noexcept : block(std::exchange(other.block, nullptr)) {}
+  cow &operator=(cow other) noexcept {
+    std::swap(block, other.block);
+    return *this;
+  }
+  ~cow() {
+    release(block);
+  }
+
+  [[nodiscard]] const T &get() const noexcept {
+    return block->value;
+  }
+  const T &operator*() const noexcept {
+    return block->value;
+  }
+  const T *operator->() const noexcept {
+    return &block->value;
+  }
+
+  /**
+   * Copies the shared instance if any other handle refers to it.
+   * @return instance owned only by this handle
+   */
+  [[nodiscard]] T &mutate() {
+    if (is_shared()) {
+      auto copy = new details::cow_block<T>{block->value};
+      release(std::exchange(block, copy));
+    }
+    return block->value;
+  }
+
+  [[nodiscard]] bool is_shared() const noexcept {
+    return block->references.load(std::memory_order_acquire) != 1;
+  }
+
+ private:
+  explicit cow(details::cow_block<T> *block) noexcept : block(block) {
+    block->references.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static void release(details::cow_block<T> *block) noexcept {
+    if (block != nullptr && block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete block;
+    }
+  }
+
+  details::cow_block<T> *block;
+};
+
 template<copyable T>
 class prototype {
   static constexpr inline bool copy_constructing = std::copy_constructible<T>;
@@ -18,6 +105,7 @@ class prototype {
 
  private:
   T prototype_instance;
+  mutable std::atomic<details::cow_block<T> *> shared_instance = nullptr;
 
  public:
   explicit prototype(const T &prototypeInstance) noexcept(is_noexcept_copyable) requires(copy_constructing) : prototype_instance(prototypeInstance) {
@@ -38,6 +126,9 @@ class prototype {
   prototype &operator=(prototype &&) = delete;
   prototype(const prototype &) = delete;
   prototype &operator=(const prototype &) = delete;
+  ~prototype() {
+    cow<T>::release(shared_instance.load(std::memory_order_acquire));
+  }
 
   T clone() const noexcept(is_noexcept_copyable) {
     if constexpr (std::copy_constructible<T>) {
@@ -69,6 +160,59 @@ class prototype {
     }
   }
 
+  /**
+   * Assigns n clones through out in one pass. Trivially copyable instances written to contiguous memory are
+   * replicated by memcpy of doubling blocks.
+   * @return iterator past the last clone
+   */
+  template<std::output_iterator<const T &> Out>
+  Out clone_n(std::size_t n, Out out) const {
+    if constexpr (std::is_trivially_copyable_v<T> && details::contiguous_iterator_of<Out, T>) {
+      if (n == 0) {
+        return out;
+      }
+      const auto data = std::to_address(out);
+      std::memcpy(data, &prototype_instance, sizeof(T));
+      for (std::size_t copied = 1; copied < n;) {
+        const auto count = std::min(copied, n - copied);
+        std::memcpy(data + copied, data, count * sizeof(T));
+        copied += count;
+      }
+      return out + n;
+    } else {
+      return std::fill_n(out, n, prototype_instance);
+    }
+  }
+
+  /**
+   * @return n clones in a single contiguous allocation
+   */
+  std::vector<T> clone_n(std::size_t n) const {
+    if constexpr (std::copy_constructible<T>) {
+      return std::vector<T>(n, prototype_instance);
+    } else {
+      auto result = std::vector<T>(n);
+      clone_n(n, result.begin());
+      return result;
+    }
+  }
+
+  /**
+   * Clone sharing a single copy of the prototype with other cow clones until it is mutated.
+   */
+  cow<T> cloneCow() const {
+    auto block = shared_instance.load(std::memory_order_acquire);
+    if (block == nullptr) {
+      auto created = new details::cow_block<T>{prototype_instance};
+      if (shared_instance.compare_exchange_strong(block, created, std::memory_order_acq_rel)) {
+        block = created;
+      } else {
+        delete created;
+      }
+    }
+    return cow<T>{block};
+  }
+
   const T &get() const noexcept {
     return prototype_instance;
   }
@@ -6,8 +6,239 @@
 #define DESIGN_PATTERNS_SINGLETON_H
 
 #include "../concepts.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 namespace pf {
+namespace details {
+/**
+ * Readable name of T taken from the compiler's function signature, e.g. "pf::singleton_profile".
+ */
+template<typename T>
+constexpr std::string_view type_name() {
+  constexpr auto signature = std::string_view{__PRETTY_FUNCTION__};
+  constexpr auto start = signature.find("T = ") + 4;
+  return signature.substr(start, signature.find_first_of(";]", start) - start);
+}
+}// namespace details
+
+struct singleton_profile {
+  std::string name;
+  std::chrono::nanoseconds construction_time;
+};
+
+/**
+ * Optional registry of singletons. Registered singletons report their construction time and can be warmed up
+ * in dependency order, singletons which are not registered never touch the registry.
+ */
+class singleton_registry {
+ public:
+  static singleton_registry &get() {
+    static singleton_registry instance{};
+    return instance;
+  }
+
+  /**
+   * Registers Singleton for warm up, it is constructed after all Dependencies which have to be registered too.
+   * name is reported by profile(), it defaults to the name of Singleton's value type.
+   * Returns true so it can initialize a static variable next to the singleton's definition.
+   */
+  template<typename Singleton, typename... Dependencies>
+  bool add(std::string name = std::string{details::type_name<typename Singleton::value_type>()}) {
+    std::unique_lock lock{mutex};
+    entries.insert_or_assign(std::type_index{typeid(Singleton)},
+                             entry{std::move(name), [] { Singleton::get_instance(); }, [] { return Singleton::construction_time(); },
+                                   {std::type_index{typeid(Dependencies)}...}});
+    return true;
+  }
+
+  /**
+   * @return construction times of registered singletons constructed so far
+   */
+  [[nodiscard]] std::vector<singleton_profile> profile() const {
+    std::unique_lock lock{mutex};
+    auto result = std::vector<singleton_profile>{};
+    for (const auto &[type, e] : entries) {
+      if (const auto construction_time = e.construction_time(); construction_time.has_value()) {
+        result.emplace_back(e.name, *construction_time);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Constructs registered singletons on the calling thread in dependency order.
+   */
+  void warm_up() {
+    for (const auto &type : topological_order()) {
+      auto init = std::function<void()>{};
+      {
+        std::unique_lock lock{mutex};
+        init = entries.at(type).init;
+      }
+      init();
+    }
+  }
+
+  /**
+   * Constructs registered singletons on executor, each one as soon as its dependencies are constructed,
+   * so independent singletons are constructed in parallel. Singletons depending on a failed one are skipped.
+   * Blocks until all are done and rethrows the first failure.
+   */
+  void warm_up(executor auto &executor) {
+    topological_order();
+    auto state = warm_up_state{};
+    {
+      std::unique_lock lock{mutex};
+      for (const auto &[type, e] : entries) {
+        state.waiting_for[type] = e.dependencies.size();
+        for (const auto &dependency : e.dependencies) {
+          state.dependents[dependency].emplace_back(type);
+        }
+      }
+    }
+    state.remaining = state.waiting_for.size();
+    auto ready = std::vector<std::type_index>{};
+    for (const auto &[type, count] : state.waiting_for) {
+      if (count == 0) {
+        ready.emplace_back(type);
+      }
+    }
+    for (const auto &type : ready) {
+      schedule(executor, state, type);
+    }
+    std::unique_lock lock{state.mutex};
+    state.done.wait(lock, [&state] { return state.remaining == 0; });
+    if (state.failure) {
+      std::rethrow_exception(state.failure);
+    }
+  }
+
+ private:
+  singleton_registry() = default;
+
+  struct entry {
+    std::string name;
+    std::function<void()> init;
+    std::function<std::optional<std::chrono::nanoseconds>()> construction_time;
+    std::vector<std::type_index> dependencies;
+  };
+
+  struct warm_up_state {
+    std::mutex mutex;
+    std::condition_variable done;
+    std::map<std::type_index, std::size_t> waiting_for;
+    std::map<std::type_index, std::vector<std::type_index>> dependents;
+    std::set<std::type_index> skipped;
+    std::size_t remaining = 0;
+    std::exception_ptr failure;
+  };
+
+  /**
+   * Marks all transitive dependents of a failed singleton as skipped, state.mutex has to be held.
+   */
+  static void skip_dependents(warm_up_state &state, std::type_index failed) {
+    auto pending = std::vector<std::type_index>{failed};
+    while (!pending.empty()) {
+      const auto type = pending.back();
+      pending.pop_back();
+      for (const auto &dependent : state.dependents[type]) {
+        if (state.skipped.insert(dependent).second) {
+          --state.remaining;
+          pending.emplace_back(dependent);
+        }
+      }
+    }
+  }
+
+  void schedule(executor auto &executor, warm_up_state &state, std::type_index type) {
+    auto init = std::function<void()>{};
+    {
+      std::unique_lock lock{mutex};
+      init = entries.at(type).init;
+    }
+    executor.enqueue([this, &executor, &state, type, init] {
+      auto failure = std::exception_ptr{};
+      try {
+        init();
+      } catch (...) {
+        failure = std::current_exception();
+      }
+      auto ready = std::vector<std::type_index>{};
+      {
+        std::unique_lock lock{state.mutex};
+        if (failure) {
+          if (!state.failure) {
+            state.failure = failure;
+          }
+          skip_dependents(state, type);
+        } else {
+          for (const auto &dependent : state.dependents[type]) {
+            if (--state.waiting_for[dependent] == 0 && !state.skipped.contains(dependent)) {
+              ready.emplace_back(dependent);
+            }
+          }
+        }
+        if (--state.remaining == 0) {
+          state.done.notify_all();
+        }
+      }
+      for (const auto &dependent : ready) {
+        schedule(executor, state, dependent);
+      }
+    });
+  }
+
+  /**
+   * @throws std::logic_error on a dependency cycle or an unregistered dependency
+   */
+  std::vector<std::type_index> topological_order() const {
+    std::unique_lock lock{mutex};
+    auto waiting_for = std::map<std::type_index, std::size_t>{};
+    auto dependents = std::map<std::type_index, std::vector<std::type_index>>{};
+    auto result = std::vector<std::type_index>{};
+    for (const auto &[type, e] : entries) {
+      waiting_for[type] = e.dependencies.size();
+      for (const auto &dependency : e.dependencies) {
+        if (!entries.contains(dependency)) {
+          throw std::logic_error(std::string{"Singleton dependency is not registered: "} + dependency.name());
+        }
+        dependents[dependency].emplace_back(type);
+      }
+      if (e.dependencies.empty()) {
+        result.emplace_back(type);
+      }
+    }
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      for (const auto &dependent : dependents[result[i]]) {
+        if (--waiting_for[dependent] == 0) {
+          result.emplace_back(dependent);
+        }
+      }
+    }
+    if (result.size() != entries.size()) {
+      throw std::logic_error("Dependency cycle between singletons.");
+    }
+    return result;
+  }
+
+  mutable std::mutex mutex;
+  std::unordered_map<std::type_index, entry> entries;
+};
+
 template<typename T, invocable_returning<T> Creator>
 class singleton {
  public:
@@ -43,8 +274,25 @@ class singleton {
     return value;
   }
 
+  /**
+   * @return time the instance took to construct, empty until it is constructed
+   */
+  static std::optional<std::chrono::nanoseconds> construction_time() {
+    if (!constructed.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    return construction_duration;
+  }
+
  private:
-  singleton() : value(Creator{}()) {}
+  singleton() : singleton(std::chrono::steady_clock::now()) {}
+  explicit singleton(std::chrono::steady_clock::time_point construction_start) : value(Creator{}()) {
+    construction_duration = std::chrono::steady_clock::now() - construction_start;
+    constructed.store(true, std::memory_order_release);
+  }
+
+  static inline std::chrono::nanoseconds construction_duration{};
+  static inline std::atomic<bool> constructed = false;
   T value;
 };
 }
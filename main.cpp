@@ -9,15 +9,20 @@
 #include "creational/object_pool.h"
 #include "creational/prototype.h"
 #include "creational/singleton.h"
+#include <bit>
 #include <cassert>
 #include <concepts>
 #include <coroutine>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <optional>
 #include <queue>
+#include <ranges>
 #include <sstream>
 #include <stack>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 
 struct Test {
@@ -534,7 +539,182 @@ class Package {
   int deliveryCost;
 };
 
+struct TaskTrace {
+  using clock = std::chrono::steady_clock;
+  std::uint64_t taskId = 0;
+  const char *name = "task";
+  std::array<char, 32> event{};
+  clock::time_point enqueueTime;
+  clock::time_point dequeueTime;
+  clock::time_point startTime;
+  clock::time_point endTime;
+};
+
+/**
+ * Single producer lock-free ring buffer owned by one thread, keeps the latest capacity records.
+ * Each slot is guarded by a sequence number, snapshots skip records overwritten while being read.
+ */
+class TraceRingBuffer {
+  static_assert(std::is_trivially_copyable_v<TaskTrace> && sizeof(TaskTrace) % sizeof(std::uint64_t) == 0);
+  static constexpr std::size_t SlotWords = sizeof(TaskTrace) / sizeof(std::uint64_t);
+
+  struct Slot {
+    // 2 * (position + 1) once the record at position is written, odd while it is being written
+    std::atomic<std::size_t> sequence = 0;
+    std::array<std::atomic<std::uint64_t>, SlotWords> words{};
+  };
+
+ public:
+  TraceRingBuffer(uint32_t threadIndex, std::size_t capacity) : threadIndex(threadIndex), slots(capacity) {}
+
+  void push(const TaskTrace &trace) {
+    const auto pos = head.load(std::memory_order_relaxed);
+    auto &slot = slots[pos % slots.size()];
+    const auto words = std::bit_cast<std::array<std::uint64_t, SlotWords>>(trace);
+    slot.sequence.store(2 * pos + 1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < SlotWords; ++i) {
+      slot.words[i].store(words[i], std::memory_order_release);
+    }
+    slot.sequence.store(2 * pos + 2, std::memory_order_release);
+    head.store(pos + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] std::vector<TaskTrace> snapshot() const {
+    const auto end = head.load(std::memory_order_acquire);
+    const auto begin = end > slots.size() ? end - slots.size() : 0;
+    std::vector<TaskTrace> result;
+    result.reserve(end - begin);
+    for (auto pos = begin; pos < end; ++pos) {
+      const auto &slot = slots[pos % slots.size()];
+      if (slot.sequence.load(std::memory_order_acquire) != 2 * pos + 2) {
+        continue;
+      }
+      auto words = std::array<std::uint64_t, SlotWords>{};
+      for (std::size_t i = 0; i < SlotWords; ++i) {
+        words[i] = slot.words[i].load(std::memory_order_acquire);
+      }
+      if (slot.sequence.load(std::memory_order_relaxed) != 2 * pos + 2) {
+        continue;
+      }
+      result.emplace_back(std::bit_cast<TaskTrace>(words));
+    }
+    return result;
+  }
+
+  [[nodiscard]] uint32_t getThreadIndex() const {
+    return threadIndex;
+  }
+
+ private:
+  uint32_t threadIndex;
+  std::vector<Slot> slots;
+  std::atomic<std::size_t> head = 0;
+};
+
+/**
+ * Records traces of tasks executed by ThreadPool into per thread ring buffers.
+ * When disabled the only cost is a relaxed atomic load per submitted task.
+ */
+class TaskTracer {
+ public:
+  static constexpr std::size_t BufferCapacity = 4096;
+
+  void setEnabled(bool enabled) {
+    TaskTracer::enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] TaskTrace begin(const char *name) {
+    auto result = TaskTrace{};
+    result.taskId = nextTaskId++;
+    result.name = name;
+    result.enqueueTime = result.dequeueTime = TaskTrace::clock::now();
+    return result;
+  }
+
+  void record(const TaskTrace &trace) {
+    thread_local TraceRingBuffer *localBuffer = nullptr;
+    if (localBuffer == nullptr) {
+      std::unique_lock lck{mtx};
+      localBuffer = buffers.emplace_back(std::make_unique<TraceRingBuffer>(buffers.size(), BufferCapacity)).get();
+    }
+    localBuffer->push(trace);
+  }
+
+  /**
+   * Writes recorded traces in Chrome trace event format, loadable by chrome://tracing and Perfetto.
+   */
+  void dumpChromeTrace(std::ostream &stream) {
+    std::unique_lock lck{mtx};
+    const auto toMicros = [this](TaskTrace::clock::time_point time) {
+      return std::chrono::duration_cast<std::chrono::microseconds>(time - epoch).count();
+    };
+    stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+    auto first = true;
+    for (const auto &buffer : buffers) {
+      for (const auto &trace : buffer->snapshot()) {
+        if (!first) {
+          stream << ',';
+        }
+        first = false;
+        stream << R"({"name":")" << trace.name << R"(","ph":"X","pid":0,"tid":)" << buffer->getThreadIndex()
+               << R"(,"ts":)" << toMicros(trace.startTime)
+               << R"(,"dur":)" << toMicros(trace.endTime) - toMicros(trace.startTime)
+               << R"(,"args":{"task":)" << trace.taskId
+               << R"(,"enqueue_ts":)" << toMicros(trace.enqueueTime)
+               << R"(,"dequeue_ts":)" << toMicros(trace.dequeueTime)
+               << R"(,"wait_us":)" << toMicros(trace.startTime) - toMicros(trace.enqueueTime);
+        if (trace.event.front() != '\0') {
+          stream << R"(,"event":")";
+          for (auto c : std::string_view{trace.event.data()}) {
+            if (c == '"' || c == '\\') {
+              stream << '\\' << c;
+            } else if (static_cast<unsigned char>(c) >= 0x20) {
+              stream << c;
+            }
+          }
+          stream << '"';
+        }
+        stream << "}}";
+      }
+    }
+    stream << "]}";
+  }
+
+ private:
+  std::atomic<bool> enabled = false;
+  std::atomic<std::uint64_t> nextTaskId = 0;
+  const TaskTrace::clock::time_point epoch = TaskTrace::clock::now();
+  std::mutex mtx;
+  std::vector<std::unique_ptr<TraceRingBuffer>> buffers;
+};
+
+struct TaskTracerCreator {
+  TaskTracer operator()() {
+    return TaskTracer{};
+  }
+};
+
+using Tracer = pf::singleton<TaskTracer, TaskTracerCreator>;
+
+struct TracedTask {
+  std::function<void()> fnc;
+  TaskTrace trace;
+
+  void operator()() {
+    trace.startTime = TaskTrace::clock::now();
+    fnc();
+    trace.endTime = TaskTrace::clock::now();
+    Tracer::get_instance()->record(trace);
+  }
+};
+
 class ThreadPool {
+  using Callable = std::function<void()>;
+
  public:
   explicit ThreadPool(uint32_t poolSize) : running(true) {
     for (auto i = 0; i < poolSize; ++i) {
@@ -543,14 +723,42 @@ class ThreadPool {
   }
 
   void enqueue(std::invocable auto &&f) {
+    auto task = prepareTask(Callable{std::forward<decltype(f)>(f)});
     std::unique_lock lck{mtx};
     const auto wakeup = queueTask.empty();
-    queueTask.emplace(std::forward<decltype(f)>(f));
+    queueTask.emplace(std::move(task));
     if (wakeup) {
       cv.notify_one();
     }
   }
 
+  /**
+   * Queues all tasks under a single lock and wakes at most as many idle workers as there are new tasks.
+   */
+  template<std::ranges::input_range R>
+  requires std::invocable<std::ranges::range_reference_t<R>>
+  void enqueue_bulk(R &&tasks) {
+    auto batch = std::vector<Callable>{};
+    if constexpr (std::ranges::sized_range<R>) {
+      batch.reserve(std::ranges::size(tasks));
+    }
+    for (auto &&task : tasks) {
+      if constexpr (std::is_lvalue_reference_v<R>) {
+        batch.emplace_back(prepareTask(Callable{task}));
+      } else {
+        batch.emplace_back(prepareTask(Callable{std::move(task)}));
+      }
+    }
+    std::unique_lock lck{mtx};
+    for (auto &task : batch) {
+      queueTask.emplace(std::move(task));
+    }
+    const auto toWake = std::min(batch.size(), idleWorkers);
+    for (std::size_t i = 0; i < toWake; ++i) {
+      cv.notify_one();
+    }
+  }
+
   void stop() {
     std::unique_lock lck{mtx};
     running = false;
@@ -564,10 +772,23 @@ class ThreadPool {
   }
 
  private:
+  static Callable prepareTask(Callable &&task) {
+    if (Tracer::get_instance()->isEnabled()) {
+      if (auto traced = task.target<TracedTask>(); traced != nullptr) {
+        traced->trace.dequeueTime = TaskTrace::clock::now();
+      } else {
+        return TracedTask{std::move(task), Tracer::get_instance()->begin("task")};
+      }
+    }
+    return std::move(task);
+  }
+
   std::optional<std::function<void()>> getTask() {
     std::unique_lock lck{mtx};
     if (queueTask.empty()) {
+      ++idleWorkers;
       cv.wait(lck);
+      --idleWorkers;
     }
     if (!queueTask.empty()) {
       auto task = std::move(queueTask.front());
@@ -591,48 +812,149 @@ class ThreadPool {
 
   std::atomic<bool> running;
   std::vector<std::thread> threads;
+  std::size_t idleWorkers = 0;
 
-  using Callable = std::function<void()>;
   std::queue<Callable> queueTask;
 };
 
+enum class NotifyPolicy {
+  Immediate,
+  Coalesce,
+  Debounce,
+  Throttle
+};
+
+struct NotifyOptions {
+  NotifyPolicy policy = NotifyPolicy::Immediate;
+  std::chrono::milliseconds interval{0};
+};
+
+enum class DispatcherQueue {
+  Task,
+  Delayed,
+  Event,
+  PayloadEvent
+};
+
+/**
+ * Block waits for free space, FailFast rejects the new item,
+ * DropOldest discards the oldest queued item (the one due first for delayed tasks), DropNewest discards the new item.
+ * Rejected submissions throw std::runtime_error, except under DropNewest where they are dropped silently.
+ */
+enum class OverflowPolicy {
+  Block,
+  FailFast,
+  DropOldest,
+  DropNewest
+};
+
+struct QueueLimit {
+  std::size_t capacity = std::numeric_limits<std::size_t>::max();
+  OverflowPolicy policy = OverflowPolicy::Block;
+};
+
+struct QueueStats {
+  std::size_t depth = 0;
+  std::size_t maxDepth = 0;
+  std::size_t dropped = 0;
+  std::size_t rejected = 0;
+};
+
 template<typename EventId = std::string>
 class Dispatcher {
   ThreadPool pool{4};
+  using Callable = std::function<void()>;
 
  public:
   template<typename T = void>
   std::future<T> enqueue(std::invocable auto &&callable) {
+    auto [qCallable, future] = makeTask<T>(std::forward<decltype(callable)>(callable));
     std::unique_lock lck(q_mtx);
-    const auto wakeUp = isSleeping();
-    auto promisePtr = new std::promise<T>();
-    auto future = promisePtr->get_future();
-    auto qCallable = [promisePtr, callable]() mutable {
-      auto promise = std::unique_ptr<std::promise<T>>(promisePtr);
-      if constexpr (std::same_as<T, void>) {
-        callable();
-        promise->set_value();
-      } else {
-        promise->set_value(callable());
+    if (!admit(DispatcherQueue::Task, queueTask, lck, true)) {
+      onRejected(DispatcherQueue::Task);
+      return std::move(future);
+    }
+    pushTask(std::move(qCallable));
+    return std::move(future);
+  }
+
+  /**
+   * Submits all callables under a single lock.
+   * A rejected callable is handled as in enqueue, callables queued before it stay queued.
+   */
+  template<typename T = void, std::ranges::input_range R>
+  requires std::invocable<std::ranges::range_reference_t<R>>
+  std::vector<std::future<T>> enqueue_bulk(R &&callables) {
+    auto tasks = std::vector<Callable>{};
+    auto futures = std::vector<std::future<T>>{};
+    if constexpr (std::ranges::sized_range<R>) {
+      tasks.reserve(std::ranges::size(callables));
+      futures.reserve(std::ranges::size(callables));
+    }
+    for (auto &&callable : callables) {
+      auto [qCallable, future] = makeTask<T>(std::forward<decltype(callable)>(callable));
+      tasks.emplace_back(std::move(qCallable));
+      futures.emplace_back(std::move(future));
+    }
+    std::unique_lock lck(q_mtx);
+    for (auto &task : tasks) {
+      if (!admit(DispatcherQueue::Task, queueTask, lck, true)) {
+        onRejected(DispatcherQueue::Task);
+        continue;
       }
-    };
-    queueTask.emplace(std::move(qCallable));
-    if (wakeUp) {
-      main_cv.notify_one();
+      pushTask(std::move(task));
     }
-    return future;
+    return futures;
+  }
+
+  /**
+   * Never blocks.
+   * @return std::nullopt if the task queue is full and its policy does not allow dropping the oldest task
+   */
+  template<typename T = void>
+  std::optional<std::future<T>> try_enqueue(std::invocable auto &&callable) {
+    auto [qCallable, future] = makeTask<T>(std::forward<decltype(callable)>(callable));
+    std::unique_lock lck(q_mtx);
+    if (!admit(DispatcherQueue::Task, queueTask, lck, false)) {
+      return std::nullopt;
+    }
+    pushTask(std::move(qCallable));
+    return std::move(future);
   }
 
   void delayed(std::chrono::milliseconds delay, std::invocable auto &&callable) {
     std::unique_lock lck(q_mtx);
+    if (!admit(DispatcherQueue::Delayed, delayedTasks, lck, true)) {
+      onRejected(DispatcherQueue::Delayed);
+      return;
+    }
     const auto wakeUp = isSleeping();
     const auto execTime = std::chrono::steady_clock::now() + delay;
-    delayedTasks.emplace(execTime, callable);
+    delayedTasks.emplace(execTime, traced(Callable{callable}, "delayed"));
+    recordDepth(DispatcherQueue::Delayed, delayedTasks.size());
     if (wakeUp) {
       main_cv.notify_one();
     }
   }
 
+  void setQueueLimit(DispatcherQueue queue, QueueLimit limit) {
+    std::unique_lock lck(q_mtx);
+    queueLimits[static_cast<std::size_t>(queue)] = limit;
+    space_cv.notify_all();
+  }
+
+  QueueStats queueStats(DispatcherQueue queue) {
+    std::unique_lock lck(q_mtx);
+    auto result = queueCounters[static_cast<std::size_t>(queue)];
+    switch (queue) {
+      case DispatcherQueue::Task: result.depth = queueTask.size(); break;
+      case DispatcherQueue::Delayed: result.depth = delayedTasks.size(); break;
+      case DispatcherQueue::Event: result.depth = queuedEvent.size(); break;
+      case DispatcherQueue::PayloadEvent: result.depth = queuedPayloadEvent.size(); break;
+    }
+    return result;
+  }
+
   void start() {
     running = true;
     mainThread = std::thread([this] {
@@ -647,12 +969,42 @@ class Dispatcher {
   void notify(EventId event) {
     std::unique_lock lck(q_mtx);
     const auto wakeUp = isSleeping();
-    queuedEvent.emplace(event);
+    switch (scheduleEvent(event, lck)) {
+      case ScheduleResult::Scheduled: break;
+      case ScheduleResult::Merged:
+        ++mergedCounts[event];
+        ++mergedTotal;
+        return;
+      case ScheduleResult::Rejected:
+        onRejected(DispatcherQueue::Event);
+        return;
+    }
     if (wakeUp) {
       main_cv.notify_one();
     }
   }
 
+  /**
+   * Coalesce drops notifications of an event which is already pending delivery.
+   * Debounce delivers once no notification came for interval, Throttle delivers at most once per interval.
+   */
+  void setNotifyOptions(EventId event, NotifyOptions options) {
+    std::unique_lock lck(q_mtx);
+    notifyOptions.insert_or_assign(std::move(event), options);
+  }
+
+  std::size_t mergedNotifications(const EventId &event) {
+    std::unique_lock lck(q_mtx);
+    if (const auto iter = mergedCounts.find(event); iter != mergedCounts.end()) {
+      return iter->second;
+    }
+    return 0;
+  }
+
+  std::size_t mergedNotifications() const {
+    return mergedTotal;
+  }
+
   class Canceler {
    public:
     explicit Canceler(std::invocable auto &&f) : fnc(f) {}
@@ -673,7 +1025,73 @@ class Dispatcher {
     const auto id = generateId();
     eventListeners[event].emplace_back(id, std::forward<decltype(observer)>(observer));
     return Canceler([this, event, id] {
-      removeObserver(event, id);
+      removeObserver(eventListeners, event, id);
+    });
+  }
+
+  /**
+   * Typed event channel. Payloads are stored once in a slot leased from the channel's pool
+   * and shared by all listeners, the slot is reset and returns to the pool after the last listener is done.
+   * An event id should only be used with a single payload type.
+   */
+  template<std::default_initializable Payload, std::size_t PoolSize = 64>
+  class Channel {
+    friend class Dispatcher;
+    using PayloadPool = pf::object_pool<Payload, PoolSize, pf::pool_alloc_strategy::on_demand>;
+
+   public:
+    explicit Channel(EventId event) : event(std::move(event)), payloadPool(std::make_shared<PayloadPool>()) {}
+
+    [[nodiscard]] const EventId &getEvent() const {
+      return event;
+    }
+
+   private:
+    /**
+     * Falls back to a heap allocated payload when all slots are in use.
+     */
+    std::shared_ptr<const Payload> store(Payload &&payload) {
+      auto slot = payloadPool->try_lease();
+      if (slot == nullptr) {
+        return std::make_shared<const Payload>(std::move(payload));
+      }
+      auto stored = std::shared_ptr<Payload>(slot.get(), [pool = payloadPool](Payload *ptr) {
+        *ptr = Payload{};
+        pool->release(std::experimental::make_observer(ptr));
+      });
+      *stored = std::move(payload);
+      return stored;
+    }
+
+    EventId event;
+    std::shared_ptr<PayloadPool> payloadPool;
+  };
+
+  template<typename Payload, std::size_t PoolSize>
+  void notify(Channel<Payload, PoolSize> &channel, Payload payload) {
+    auto storedPayload = channel.store(std::move(payload));
+    std::unique_lock lck(q_mtx);
+    if (!admit(DispatcherQueue::PayloadEvent, queuedPayloadEvent, lck, true)) {
+      onRejected(DispatcherQueue::PayloadEvent);
+      return;
+    }
+    const auto wakeUp = isSleeping();
+    queuedPayloadEvent.emplace(channel.event, std::move(storedPayload));
+    recordDepth(DispatcherQueue::PayloadEvent, queuedPayloadEvent.size());
+    if (wakeUp) {
+      main_cv.notify_one();
+    }
+  }
+
+  template<typename Payload, std::size_t PoolSize>
+  Canceler observe(const Channel<Payload, PoolSize> &channel, std::invocable<const Payload &> auto &&observer) {
+    std::unique_lock lck(q_mtx);
+    const auto id = generateId();
+    payloadListeners[channel.event].emplace_back(id, [observer = std::forward<decltype(observer)>(observer)](const void *payload) mutable {
+      observer(*static_cast<const Payload *>(payload));
+    });
+    return Canceler([this, event = channel.event, id] {
+      removeObserver(payloadListeners, event, id);
     });
   }
 
@@ -695,11 +1113,173 @@ class Dispatcher {
   void stop() {
     running = false;
     pool.stop();
+    std::unique_lock lck(q_mtx);
+    stopped = true;
+    space_cv.notify_all();
+    main_cv.notify_all();
   }
 
  private:
   bool isSleeping() const {
-    return queueTask.empty() && delayedTasks.empty() && queuedEvent.empty() && periodicTasks.empty();
+    return sleeping;
+  }
+
+  template<typename T>
+  static std::pair<Callable, std::future<T>> makeTask(std::invocable auto &&callable) {
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future = promise->get_future();
+    auto qCallable = [promise, callable = std::forward<decltype(callable)>(callable)]() mutable {
+      if constexpr (std::same_as<T, void>) {
+        callable();
+        promise->set_value();
+      } else {
+        promise->set_value(callable());
+      }
+    };
+    return {std::move(qCallable), std::move(future)};
+  }
+
+  static Callable traced(Callable &&task, const char *name) {
+    if (!Tracer::get_instance()->isEnabled()) {
+      return std::move(task);
+    }
+    return TracedTask{std::move(task), Tracer::get_instance()->begin(name)};
+  }
+
+  static Callable traced(Callable &&task, const char *name, const EventId &event) {
+    if (!Tracer::get_instance()->isEnabled()) {
+      return std::move(task);
+    }
+    auto trace = Tracer::get_instance()->begin(name);
+    if constexpr (requires(std::ostream &o, const EventId &e) { o << e; }) {
+      auto ss = std::ostringstream{};
+      ss << event;
+      const auto eventStr = ss.str();
+      std::copy_n(eventStr.begin(), std::min(eventStr.size(), trace.event.size() - 1), trace.event.begin());
+    }
+    return TracedTask{std::move(task), trace};
+  }
+
+  void pushTask(Callable &&task) {
+    const auto wakeUp = isSleeping();
+    queueTask.emplace(traced(std::move(task), "task"));
+    recordDepth(DispatcherQueue::Task, queueTask.size());
+    if (wakeUp) {
+      main_cv.notify_one();
+    }
+  }
+
+  /**
+   * Makes room for a new item in queue according to its overflow policy, q_mtx has to be held by lck.
+   * @return false if the new item must not be queued
+   */
+  bool admit(DispatcherQueue kind, auto &queue, std::unique_lock<std::mutex> &lck, bool canBlock) {
+    const auto idx = static_cast<std::size_t>(kind);
+    if (queue.size() < queueLimits[idx].capacity) {
+      return true;
+    }
+    switch (queueLimits[idx].policy) {
+      case OverflowPolicy::Block:
+        if (canBlock) {
+          space_cv.wait(lck, [&] { return queue.size() < queueLimits[idx].capacity || stopped; });
+          if (queue.size() < queueLimits[idx].capacity) {
+            return true;
+          }
+        }
+        break;
+      case OverflowPolicy::DropOldest:
+        while (!queue.empty() && queue.size() >= queueLimits[idx].capacity) {
+          dropOldest(queue);
+          ++queueCounters[idx].dropped;
+        }
+        if (queueLimits[idx].capacity > 0) {
+          return true;
+        }
+        break;
+      case OverflowPolicy::FailFast:
+      case OverflowPolicy::DropNewest: break;
+    }
+    ++queueCounters[idx].rejected;
+    return false;
+  }
+
+  void dropOldest(std::queue<EventId> &queue) {
+    pendingEvents.erase(queue.front());
+    queue.pop();
+  }
+
+  void dropOldest(auto &queue) {
+    queue.pop();
+  }
+
+  void onRejected(DispatcherQueue kind) const {
+    if (queueLimits[static_cast<std::size_t>(kind)].policy != OverflowPolicy::DropNewest) {
+      throw std::runtime_error("Dispatcher queue is full.");
+    }
+  }
+
+  void recordDepth(DispatcherQueue kind, std::size_t depth) {
+    auto &maxDepth = queueCounters[static_cast<std::size_t>(kind)].maxDepth;
+    maxDepth = std::max(maxDepth, depth);
+  }
+
+  enum class ScheduleResult {
+    Scheduled,
+    Merged,
+    Rejected
+  };
+
+  ScheduleResult pushEvent(const EventId &event, std::unique_lock<std::mutex> &lck) {
+    if (!admit(DispatcherQueue::Event, queuedEvent, lck, true)) {
+      return ScheduleResult::Rejected;
+    }
+    queuedEvent.emplace(event);
+    recordDepth(DispatcherQueue::Event, queuedEvent.size());
+    return ScheduleResult::Scheduled;
+  }
+
+  ScheduleResult scheduleEvent(const EventId &event, std::unique_lock<std::mutex> &lck) {
+    const auto optionsIter = notifyOptions.find(event);
+    if (optionsIter == notifyOptions.end()) {
+      return pushEvent(event, lck);
+    }
+    const auto options = optionsIter->second;
+    const auto currentTime = std::chrono::steady_clock::now();
+    switch (options.policy) {
+      case NotifyPolicy::Immediate:
+        return pushEvent(event, lck);
+      case NotifyPolicy::Coalesce: {
+        if (pendingEvents.contains(event)) {
+          return ScheduleResult::Merged;
+        }
+        if (!admit(DispatcherQueue::Event, queuedEvent, lck, true)) {
+          return ScheduleResult::Rejected;
+        }
+        if (!pendingEvents.insert(event).second) {
+          return ScheduleResult::Merged;
+        }
+        queuedEvent.emplace(event);
+        recordDepth(DispatcherQueue::Event, queuedEvent.size());
+        return ScheduleResult::Scheduled;
+      }
+      case NotifyPolicy::Debounce:
+        return scheduledEvents.insert_or_assign(event, currentTime + options.interval).second ? ScheduleResult::Scheduled : ScheduleResult::Merged;
+      case NotifyPolicy::Throttle: {
+        if (scheduledEvents.contains(event)) {
+          return ScheduleResult::Merged;
+        }
+        if (const auto lastIter = lastDeliveries.find(event); lastIter != lastDeliveries.end() && lastIter->second + options.interval > currentTime) {
+          scheduledEvents.emplace(event, lastIter->second + options.interval);
+          return ScheduleResult::Scheduled;
+        }
+        const auto result = pushEvent(event, lck);
+        if (result == ScheduleResult::Scheduled) {
+          lastDeliveries.insert_or_assign(event, currentTime);
+        }
+        return result;
+      }
+    }
+    return ScheduleResult::Scheduled;
   }
 
   struct TimedCallable {
@@ -725,8 +1305,8 @@ class Dispatcher {
     }
   };
 
-  void removeObserver(EventId event, uint32_t observerId) {
-    if (auto iter = eventListeners.find(event); iter != eventListeners.end()) {
+  void removeObserver(auto &listeners, const EventId &event, uint32_t observerId) {
+    if (auto iter = listeners.find(event); iter != listeners.end()) {
       if (auto i = std::find_if(iter->second.begin(), iter->second.end(), [observerId](const auto &pair) {
             return pair.first == observerId;
           });
@@ -738,61 +1318,134 @@ class Dispatcher {
 
   void run() {
     while (running) {
-      if (queueTask.empty() && delayedTasks.empty() && queuedEvent.empty()) {
-        std::unique_lock lck(main_mtx);
-        main_cv.wait(lck);
+      std::unique_lock lck(q_mtx);
+      if (queueTask.empty() && queuedEvent.empty() && queuedPayloadEvent.empty()) {
+        waitForWork(lck);
       }
       if (!paused) {
-        std::unique_lock lck(q_mtx);
         runDelayed();
         enqueueTaskToPool();
+        runScheduledEvents();
         notifyEvents();
+        space_cv.notify_all();
+      }
+    }
+  }
+
+  /**
+   * Sleeps until notified or until the earliest delayed task or debounced/throttled event is due.
+   */
+  void waitForWork(std::unique_lock<std::mutex> &lck) {
+    if (!running) {
+      return;
+    }
+    sleeping = true;
+    if (const auto deadline = nextDeadline()) {
+      main_cv.wait_until(lck, *deadline);
+    } else {
+      main_cv.wait(lck);
+    }
+    sleeping = false;
+  }
+
+  std::optional<std::chrono::steady_clock::time_point> nextDeadline() const {
+    auto result = std::optional<std::chrono::steady_clock::time_point>{};
+    if (!delayedTasks.empty()) {
+      result = delayedTasks.top().execTime;
+    }
+    for (const auto &[event, deadline] : scheduledEvents) {
+      if (!result || deadline < *result) {
+        result = deadline;
       }
     }
+    return result;
   }
 
   void runDelayed() {
     const auto currentTime = std::chrono::steady_clock::now();
     while (!delayedTasks.empty() && delayedTasks.top().execTime <= currentTime) {
-      pool.enqueue(std::move(delayedTasks.top()));
+      pool.enqueue(delayedTasks.top().fnc);
       delayedTasks.pop();
     }
   }
 
   void enqueueTaskToPool() {
+    if (queueTask.empty()) {
+      return;
+    }
+    auto batch = std::vector<Callable>{};
+    batch.reserve(queueTask.size());
     while (!queueTask.empty()) {
-      pool.enqueue(std::move(queueTask.front()));
+      batch.emplace_back(std::move(queueTask.front()));
       queueTask.pop();
     }
+    pool.enqueue_bulk(std::move(batch));
+  }
+
+  void runScheduledEvents() {
+    const auto currentTime = std::chrono::steady_clock::now();
+    for (auto iter = scheduledEvents.begin(); iter != scheduledEvents.end();) {
+      if (iter->second > currentTime) {
+        ++iter;
+        continue;
+      }
+      queuedEvent.emplace(iter->first);
+      if (auto lastIter = lastDeliveries.find(iter->first); lastIter != lastDeliveries.end()) {
+        lastIter->second = currentTime;
+      }
+      iter = scheduledEvents.erase(iter);
+    }
   }
 
   void notifyEvents() {
     while (!queuedEvent.empty()) {
+      pendingEvents.erase(queuedEvent.front());
       if (auto iter = eventListeners.find(queuedEvent.front()); iter != eventListeners.end()) {
-        pool.enqueue([iter] {
+        pool.enqueue(traced([iter] {
           for (auto &[id, listener] : iter->second) {
             listener();
           }
-        });
+        }, "event", queuedEvent.front()));
       }
       queuedEvent.pop();
     }
+    while (!queuedPayloadEvent.empty()) {
+      auto &[event, payload] = queuedPayloadEvent.front();
+      if (auto iter = payloadListeners.find(event); iter != payloadListeners.end()) {
+        pool.enqueue(traced([iter, payload = std::move(payload)] {
+          for (auto &[id, listener] : iter->second) {
+            listener(payload.get());
+          }
+        }, "payload_event", event));
+      }
+      queuedPayloadEvent.pop();
+    }
   }
 
-  std::mutex main_mtx;
   std::mutex q_mtx;
   std::condition_variable main_cv;
+  std::condition_variable space_cv;
 
   std::thread mainThread;
-  using Callable = std::function<void()>;
   std::queue<Callable> queueTask;
 
   std::priority_queue<TimedCallable, std::vector<TimedCallable>, std::greater<>> delayedTasks;
   std::priority_queue<TimedCallable, std::vector<TimedCallable>, std::greater<>> periodicTasks;
   std::atomic<bool> running;
   std::atomic<bool> paused;
+  std::atomic<bool> stopped = false;
+  bool sleeping = false;
 
   std::queue<EventId> queuedEvent;
+  std::unordered_map<EventId, NotifyOptions> notifyOptions;
+  std::unordered_set<EventId> pendingEvents;
+  std::unordered_map<EventId, std::chrono::steady_clock::time_point> scheduledEvents;
+  std::unordered_map<EventId, std::chrono::steady_clock::time_point> lastDeliveries;
+  std::unordered_map<EventId, std::size_t> mergedCounts;
+  std::atomic<std::size_t> mergedTotal = 0;
+
+  std::array<QueueLimit, 4> queueLimits{};
+  std::array<QueueStats, 4> queueCounters{};
   using EventListenerFnc = std::function<void()>;
   using EventListenerId = uint32_t;
   using EventListener = std::pair<EventListenerId, EventListenerFnc>;
@@ -802,6 +1455,11 @@ class Dispatcher {
   }
 
   std::unordered_map<EventId, std::vector<EventListener>> eventListeners;
+
+  std::queue<std::pair<EventId, std::shared_ptr<const void>>> queuedPayloadEvent;
+  using PayloadListenerFnc = std::function<void(const void *)>;
+  using PayloadListener = std::pair<EventListenerId, PayloadListenerFnc>;
+  std::unordered_map<EventId, std::vector<PayloadListener>> payloadListeners;
 };
 
 template <typename I, typename S>